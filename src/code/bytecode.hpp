@@ -30,11 +30,20 @@ enum class bytecode : unsigned char {
   STORE_SUBSCR = 60,
   DELETE_SUBSCR = 61,
 
+  BINARY_AND = 64,
+  BINARY_XOR = 65,
+  BINARY_OR = 66,
+
   GET_ITER = 68,
+  GET_YIELD_FROM_ITER = 69,
 
   LOAD_BUILD_CLASS = 0x47,
 
-  PRINT_NEWLINE = 72,
+  YIELD_FROM = 72,
+
+  INPLACE_AND = 77,
+  INPLACE_XOR = 78,
+  INPLACE_OR = 79,
 
   BREAK_LOOP = 80,
   LOAD_LOCALS = 82,
@@ -71,6 +80,7 @@ enum class bytecode : unsigned char {
   LOAD_NAME = 101,  /* Index in name list */
   BUILD_TUPLE = 102,
   BUILD_LIST = 103,
+  BUILD_SET = 104,
   BUILD_MAP = 105,
   LOAD_ATTR = 106,            /* Index in name list */
   COMPARE_OP = 107,           /* Comparison operator */
@@ -106,6 +116,7 @@ enum class bytecode : unsigned char {
   RAISE_VARARGS = 130,
   CALL_FUNCTION = 131,
   MAKE_FUNCTION = 0x84,
+  BUILD_SLICE = 133, /* Number of items */
 
   MAKE_CLOSURE = 134, /* #free vars */
   LOAD_CLOSURE = 135, /* Load free variable from closure */
@@ -115,12 +126,19 @@ enum class bytecode : unsigned char {
   CALL_FUNCTION_VAR = 140,
   CALL_FUNCTION_KW = 0x8d,
 
+  LIST_APPEND = 145, /* list is stack[-i] after popping the value */
+  SET_ADD = 146,     /* set is stack[-i] after popping the value */
+  MAP_ADD = 147,     /* dict is stack[-i] after popping key and value */
+
+  FORMAT_VALUE = 155, /* conversion in the low bits, 4 if a spec is on TOS */
   BUILD_CONST_KEY_MAP = 0x9c,
+  BUILD_STRING = 157,
 
   LOAD_METHOD = 160,
   CALL_METHOD = 161,
 
   LIST_EXTEND = 0xa2,
+  SET_UPDATE = 163,
 
 };
 
@@ -1,10 +1,21 @@
 #include "code/code_object.hpp"
+#include "code/bytecode.hpp"
 #include "object/string.hpp"
+#include "object/tuple.hpp"
+#include "runtime/function.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <optional>
+#include <utility>
 
 using namespace cppython;
 
+static std::string_view name_of(const std::shared_ptr<object> &x) {
+  return std::static_pointer_cast<string>(x)->get_value();
+}
+
 code_klass::code_klass() {
   set_name("code");
   add_super(object_klass::get_instance());
@@ -33,4 +44,273 @@ code_object::code_object(
       filename{std::move(filename)}, name{std::move(name)},
       firstlineno{firstlineno}, lnotab{std::move(lnotab)} {
   set_klass(code_klass::get_instance());
+
+  simple_signature = kwonlyargcount == 0 &&
+                     !(flags & (function::co_flags::var_args |
+                                function::co_flags::var_keywords));
+
+  assert(this->varnames &&
+         this->varnames->get_klass() == tuple_klass::get_instance());
+  auto var_names = std::static_pointer_cast<tuple>(this->varnames);
+  auto param_cnt =
+      std::min<size_t>(argcount + kwonlyargcount, var_names->size());
+  for (size_t i = 0; i < param_cnt; i++) {
+    arg_slots.emplace(name_of(var_names->at(i)), static_cast<int>(i));
+  }
+
+  assert(this->cellvars &&
+         this->cellvars->get_klass() == tuple_klass::get_instance());
+  for (const auto &x : std::static_pointer_cast<tuple>(this->cellvars)
+                           ->get_value()) {
+    auto iter = arg_slots.find(name_of(x));
+    cell_arg_slots.push_back(iter == arg_slots.end() ? -1 : iter->second);
+  }
+
+  assert(this->freevars &&
+         this->freevars->get_klass() == tuple_klass::get_instance());
+  free_cnt = std::static_pointer_cast<tuple>(this->freevars)->size();
+
+  build_handler_table();
+}
+
+namespace {
+
+/// @brief where an instruction goes and what it does to the value stack
+struct instruction_flow {
+  // falling through to the next instruction, nullopt if it never does
+  std::optional<int> effect;
+  std::optional<size_t> target;
+  int jump_effect{0};
+};
+
+/// @brief the flow of the instruction at offset, as the interpreter runs it.
+/// nullopt for an op code it doesn't run.
+std::optional<instruction_flow> flow_of(size_t offset, unsigned char op_code,
+                                        int op_arg) {
+  auto next = offset + 2;
+  switch (static_cast<bytecode>(op_code)) {
+    using enum bytecode;
+  case NOP:
+  case ROT_TWO:
+  case ROT_THREE:
+  case GET_ITER:
+  case GET_YIELD_FROM_ITER:
+  case YIELD_VALUE:
+  case POP_BLOCK:
+  case POP_EXCEPT:
+  case DELETE_NAME:
+  case LOAD_ATTR:
+  case SETUP_FINALLY:
+    return instruction_flow{.effect = 0};
+  case DUP_TOP:
+  case LOAD_BUILD_CLASS:
+  case LOAD_ASSERTION_ERROR:
+  case LOAD_LOCALS:
+  case LOAD_CONST:
+  case LOAD_NAME:
+  case LOAD_GLOBAL:
+  case LOAD_FAST:
+  case LOAD_CLOSURE:
+  case LOAD_DEREF:
+  case LOAD_METHOD:
+  case IMPORT_FROM:
+    return instruction_flow{.effect = 1};
+  case DUP_TOP_TWO:
+    return instruction_flow{.effect = 2};
+  case POP_TOP:
+  case BINARY_MULTIPLY:
+  case BINARY_MODULO:
+  case BINARY_SUBSCR:
+  case BINARY_DIVIDE:
+  case BINARY_ADD:
+  case BINARY_SUBTRACT:
+  case BINARY_AND:
+  case BINARY_XOR:
+  case BINARY_OR:
+  case INPLACE_ADD:
+  case INPLACE_SUBTRACT:
+  case INPLACE_MULTIPLY:
+  case INPLACE_DIVIDE:
+  case INPLACE_MODULO:
+  case INPLACE_AND:
+  case INPLACE_XOR:
+  case INPLACE_OR:
+  case YIELD_FROM:
+  case STORE_NAME:
+  case STORE_GLOBAL:
+  case STORE_FAST:
+  case STORE_DEREF:
+  case COMPARE_OP:
+  case IS_OP:
+  case CONTAINS_OP:
+  case IMPORT_NAME:
+  case LIST_EXTEND:
+  case LIST_APPEND:
+  case SET_ADD:
+  case SET_UPDATE:
+    return instruction_flow{.effect = -1};
+  case DELETE_SUBSCR:
+  case STORE_ATTR:
+  case MAP_ADD:
+    return instruction_flow{.effect = -2};
+  case STORE_SUBSCR:
+  case STORE_MAP:
+    return instruction_flow{.effect = -3};
+  case UNPACK_SEQUENCE:
+    return instruction_flow{.effect = op_arg - 1};
+  case BUILD_TUPLE:
+  case BUILD_LIST:
+  case BUILD_SET:
+  case BUILD_STRING:
+  case BUILD_SLICE:
+    return instruction_flow{.effect = 1 - op_arg};
+  case BUILD_MAP:
+    return instruction_flow{.effect = 1 - 2 * op_arg};
+  case BUILD_CONST_KEY_MAP:
+  case CALL_FUNCTION:
+    return instruction_flow{.effect = -op_arg};
+  case CALL_FUNCTION_KW:
+  case CALL_METHOD:
+    return instruction_flow{.effect = -op_arg - 1};
+  case MAKE_FUNCTION:
+    // code and qualified name, then one value per flag
+    return instruction_flow{
+        .effect = -1 - std::popcount(static_cast<unsigned>(op_arg) & 0xF)};
+  case FORMAT_VALUE:
+    return instruction_flow{.effect = (op_arg & 0x04) ? -1 : 0};
+  case FOR_ITER:
+    // pushes the next item, or pops the exhausted iterator and jumps
+    return instruction_flow{
+        .effect = 1, .target = next + op_arg, .jump_effect = -1};
+  case JUMP_FORWARD:
+    return instruction_flow{.target = next + op_arg};
+  case JUMP_ABSOLUTE:
+    return instruction_flow{.target = static_cast<size_t>(op_arg)};
+  case POP_JUMP_IF_FALSE:
+  case POP_JUMP_IF_TRUE:
+    return instruction_flow{.effect = -1,
+                            .target = static_cast<size_t>(op_arg),
+                            .jump_effect = -1};
+  case JUMP_IF_NOT_EXC_MATCH:
+    return instruction_flow{.effect = -2,
+                            .target = static_cast<size_t>(op_arg),
+                            .jump_effect = -2};
+  case RETURN_VALUE:
+  case RAISE_VARARGS:
+  case RERAISE:
+    return instruction_flow{};
+  default:
+    return std::nullopt;
+  }
+}
+
+} // namespace
+
+void code_object::build_handler_table() {
+  struct try_block {
+    size_t target;
+    int depth;
+  };
+  struct flow_state {
+    int depth;
+    std::vector<try_block> blocks;
+  };
+
+  // the state on entry to each instruction, reached ones only
+  auto size = code->size();
+  std::vector<std::optional<flow_state>> states(size / 2);
+  std::vector<size_t> work;
+  auto reach = [&](size_t offset, flow_state state) {
+    if (offset + 1 < size && !states[offset / 2]) {
+      states[offset / 2] = std::move(state);
+      work.push_back(offset);
+    }
+  };
+
+  reach(0, {0, {}});
+  while (!work.empty()) {
+    auto offset = work.back();
+    work.pop_back();
+    auto state = *states[offset / 2];
+
+    auto op_code = static_cast<unsigned char>(code->at(offset));
+    auto op_arg = static_cast<unsigned char>(code->at(offset + 1));
+    auto flow = flow_of(offset, op_code, op_arg);
+    if (!flow) {
+      continue;
+    }
+
+    if (op_code == std::to_underlying(bytecode::SETUP_FINALLY)) {
+      // the handler runs outside the block, with traceback, value and
+      // exception class pushed
+      auto target = offset + 2 + op_arg;
+      reach(target, {state.depth + 3, state.blocks});
+      state.blocks.push_back({target, state.depth});
+    } else if (op_code == std::to_underlying(bytecode::POP_BLOCK) &&
+               !state.blocks.empty()) {
+      state.blocks.pop_back();
+    }
+
+    if (flow->target) {
+      reach(*flow->target, {state.depth + flow->jump_effect, state.blocks});
+    }
+    if (flow->effect) {
+      reach(offset + 2, {state.depth + *flow->effect, std::move(state.blocks)});
+    }
+  }
+
+  // one entry per run of instructions inside the same innermost block
+  for (size_t i = 0; i < states.size(); i++) {
+    if (!states[i] || states[i]->blocks.empty()) {
+      continue;
+    }
+    auto &b = states[i]->blocks.back();
+    auto offset = i * 2;
+    if (!handlers.empty() && handlers.back().end == offset &&
+        handlers.back().target == b.target) {
+      handlers.back().end = offset + 2;
+    } else {
+      handlers.push_back({offset, offset + 2, b.target, b.depth});
+    }
+  }
+}
+
+int code_object::line_of(size_t offset) const {
+  if (lines.empty()) {
+    // lnotab holds (offset increment, line increment) byte pairs, the line
+    // increment is signed
+    const auto &table = std::static_pointer_cast<string>(lnotab)->get_value();
+    size_t start = 0;
+    int line = firstlineno;
+    lines.push_back({start, line});
+    for (size_t i = 0; i + 1 < table.size(); i += 2) {
+      start += static_cast<unsigned char>(table[i]);
+      line += static_cast<signed char>(table[i + 1]);
+      if (lines.back().start == start) {
+        lines.back().line = line;
+      } else {
+        lines.push_back({start, line});
+      }
+    }
+  }
+
+  auto iter = std::ranges::upper_bound(lines, offset, {}, &line_entry::start);
+  return std::prev(iter)->line;
+}
+
+const handler_entry *code_object::find_handler(size_t offset) const {
+  auto iter = std::ranges::upper_bound(handlers, offset, {},
+                                       &handler_entry::start);
+  if (iter == handlers.begin() || offset >= std::prev(iter)->end) {
+    return nullptr;
+  }
+  return &*std::prev(iter);
+}
+
+int code_object::arg_slot(const std::shared_ptr<object> &name) const {
+  if (name->get_klass() != string_klass::get_instance()) {
+    return -1;
+  }
+  auto iter = arg_slots.find(name_of(name));
+  return iter == arg_slots.end() ? -1 : iter->second;
 }
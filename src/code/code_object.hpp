@@ -5,12 +5,31 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace cppython {
 
 class string;
 class tuple;
 
+/// @brief an exception raised by an instruction in [start, end) is handled
+/// at target, with the value stack cut back to depth
+struct handler_entry {
+  size_t start;
+  size_t end;
+  size_t target;
+  int depth;
+};
+
+/// @brief the instructions from offset start up to the next entry come from
+/// source line line
+struct line_entry {
+  size_t start;
+  int line;
+};
+
 class code_klass : public klass, public singleton<code_klass> {
   friend class singleton<code_klass>;
 
@@ -52,5 +71,43 @@ public:
 
   int firstlineno;
   std::shared_ptr<object> lnotab;
+
+  /// @brief only positional parameters, no *args, **kwargs or keyword-only
+  /// ones. A call passing argcount positional arguments binds them by
+  /// copying.
+  bool simple_signature{false};
+
+  /// @brief the innermost try block around the instruction at offset
+  const handler_entry *find_handler(size_t offset) const;
+
+  /// @brief the source line of the instruction at offset. lnotab is decoded
+  /// the first time a line is asked for.
+  int line_of(size_t offset) const;
+
+  /// @brief the fast local slot of the parameter named name, or -1
+  int arg_slot(const std::shared_ptr<object> &name) const;
+  /// @brief cell variables, then free variables, are stored after the
+  /// nlocals fast locals
+  size_t cell_count() const { return cell_arg_slots.size(); }
+  size_t free_count() const { return free_cnt; }
+
+  /// @brief the slot of the parameter captured by cell i, or -1
+  int cell_arg_slot(size_t i) const { return cell_arg_slots[i]; }
+
+private:
+  /// @brief follows every path through the code, keeping the value stack
+  /// depth and the try blocks entered, so SETUP_FINALLY and POP_BLOCK need
+  /// not do anything when they run
+  void build_handler_table();
+
+  // sorted by start, ranges don't overlap
+  std::vector<handler_entry> handlers;
+  // sorted by start, empty until line_of is first called
+  mutable std::vector<line_entry> lines;
+
+  // computed once at load time, the names point into varnames
+  std::unordered_map<std::string_view, int> arg_slots;
+  std::vector<int> cell_arg_slots;
+  size_t free_cnt{0};
 };
 } // namespace cppython
@@ -2,6 +2,7 @@
 #include "code/code_object.hpp"
 #include "object/float.hpp"
 #include "object/integer.hpp"
+#include "object/set.hpp"
 #include "object/string.hpp"
 #include "object/tuple.hpp"
 #include "runtime/static_value.hpp"
@@ -67,6 +68,12 @@ std::shared_ptr<object> pyc_parser::parse_object() {
   case ')': // small tuple
     return get_tuple(ref_flag);
     break;
+  case '<': // set
+    return get_set(ref_flag, set_klass::get_instance());
+    break;
+  case '>': // frozenset
+    return get_set(ref_flag, frozenset_klass::get_instance());
+    break;
   case 'z': // short ascii
   case 'Z': // short ascii interned
     return get_short_ascii(ref_flag);
@@ -193,11 +200,28 @@ std::shared_ptr<tuple> pyc_parser::get_tuple(bool ref_flag) {
     pos = ref_table.size() - 1;
   }
   int length = reader.read<char>();
-  std::vector<std::shared_ptr<object>> list;
+  auto tmp = tuple::create(length);
+  for (int i{0}; i < length; i++) {
+    tmp->set(i, parse_object());
+  }
+  if (ref_flag) {
+    ref_table.at(pos) = tmp;
+  }
+  return tmp;
+}
+
+std::shared_ptr<set> pyc_parser::get_set(bool ref_flag, klass *k) {
+  size_t pos = -1;
+  if (ref_flag) {
+    ref_table.push_back(nullptr);
+    pos = ref_table.size() - 1;
+  }
+  int length = reader.read<int>();
+  auto tmp = std::make_shared<set>(k);
+  tmp->reserve(length);
   for (int i{0}; i < length; i++) {
-    list.push_back(parse_object());
+    tmp->add(parse_object());
   }
-  auto tmp = std::make_shared<tuple>(std::move(list));
   if (ref_flag) {
     ref_table.at(pos) = tmp;
   }
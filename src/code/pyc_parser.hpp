@@ -14,6 +14,8 @@ class integer;
 class float_num;
 class string;
 class tuple;
+class set;
+class klass;
 
 class pyc_parser {
 public:
@@ -32,6 +34,8 @@ private:
   std::shared_ptr<integer> get_integer(bool ref_flag);
   std::shared_ptr<float_num> get_float(bool ref_flag);
   std::shared_ptr<tuple> get_tuple(bool ref_flag);
+  /// @param k set_klass or frozenset_klass
+  std::shared_ptr<set> get_set(bool ref_flag, klass *k);
 
 private:
   pyc_reader reader;
@@ -1,45 +1,175 @@
 #include "inc/cppython.hpp"
+#include "object/array.hpp"
 #include "object/float.hpp"
 #include "object/integer.hpp"
 
 #include <cmath>
+#include <span>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace cppython;
 
-// issue: static value in cppython.exe and math.dll
+// issue: static value in cppython.exe and math.dll. Every klass singleton has
+// a copy in each of them, so the type of an argument is told by its name.
 
-double get_double(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto x = args->at(0);
+bool is_klass(const std::shared_ptr<object> &x, std::string_view name) {
+  return x->get_klass()->get_name() == name;
+}
+
+double get_double(const std::shared_ptr<object> &x) {
   double y = 0;
-  if (x->get_klass() == integer_klass::get_instance()) {
+  if (is_klass(x, "int")) {
     y = std::static_pointer_cast<integer>(x)->get_value();
-  } else if (x->get_klass() == float_klass::get_instance()) {
+  } else if (is_klass(x, "float")) {
     y = std::static_pointer_cast<float_num>(x)->get_value();
   }
   return y;
 }
 
-std::shared_ptr<object>
-math_sqrt(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  double x = get_double(args);
+std::shared_ptr<object> math_sqrt(vector_args_t args) {
+  double x = get_double(args[0]);
   return std::make_shared<float_num>(std::sqrt(x));
 }
 
-std::shared_ptr<object>
-math_sin(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  double x = get_double(args);
+std::shared_ptr<object> math_sin(vector_args_t args) {
+  double x = get_double(args[0]);
   return std::make_shared<float_num>(std::sin(x));
 }
 
+namespace {
+
+/// @brief the correctly rounded sum of the values added, by Shewchuk's
+/// exact partial sums as CPython's math.fsum computes it
+class exact_sum {
+public:
+  void add(double x) {
+    if (!std::isfinite(x)) {
+      special += x;
+      return;
+    }
+    // partials stay non-overlapping and increasing in magnitude
+    size_t i = 0;
+    for (size_t j = 0; j < partials.size(); j++) {
+      double y = partials[j];
+      if (std::abs(x) < std::abs(y)) {
+        std::swap(x, y);
+      }
+      double hi = x + y;
+      double lo = y - (hi - x);
+      if (lo != 0.) {
+        partials[i++] = lo;
+      }
+      x = hi;
+    }
+    partials.resize(i);
+    partials.push_back(x);
+  }
+
+  /// @brief an intermediate overflow gives an infinity: a library has no
+  /// way to raise OverflowError in the interpreter
+  double result() const {
+    if (special != 0. || std::isnan(special)) {
+      return special;
+    }
+    if (partials.empty()) {
+      return 0.;
+    }
+
+    auto n = partials.size();
+    double hi = partials[--n];
+    double lo = 0.;
+    while (n > 0 && std::isfinite(hi)) {
+      double x = hi;
+      double y = partials[--n];
+      hi = x + y;
+      lo = y - (hi - x);
+      if (lo != 0.) {
+        break;
+      }
+    }
+    // a half-way case rounds by the sign of the partials left
+    if (n > 0 && ((lo < 0. && partials[n - 1] < 0.) ||
+                  (lo > 0. && partials[n - 1] > 0.))) {
+      double y = lo * 2;
+      double x = hi + y;
+      if (y == x - hi) {
+        hi = x;
+      }
+    }
+    return hi;
+  }
+
+private:
+  std::vector<double> partials;
+  // the sum of the inf and nan values
+  double special{0.};
+};
+
+} // namespace
+
+template <typename T>
+void sum_buffer(exact_sum &sum, const buffer_view &view) {
+  for (auto v : std::span<const T>{static_cast<const T *>(view.buf),
+                                   view.len}) {
+    sum.add(static_cast<double>(v));
+  }
+}
+
+std::shared_ptr<object> math_fsum(vector_args_t args) {
+  auto &x = args[0];
+  exact_sum sum;
+
+  // read the items of an array in place, without boxing every element
+  if (is_klass(x, "array")) {
+    auto view = std::static_pointer_cast<array>(x)->get_buffer();
+    switch (view.format) {
+    case 'b':
+      sum_buffer<signed char>(sum, view);
+      break;
+    case 'h':
+      sum_buffer<short>(sum, view);
+      break;
+    case 'i':
+      sum_buffer<int>(sum, view);
+      break;
+    case 'l':
+      sum_buffer<long>(sum, view);
+      break;
+    case 'q':
+      sum_buffer<long long>(sum, view);
+      break;
+    case 'f':
+      sum_buffer<float>(sum, view);
+      break;
+    case 'd':
+      sum_buffer<double>(sum, view);
+      break;
+    }
+    return std::make_shared<float_num>(sum.result());
+  }
+
+  auto iter = x->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    sum.add(get_double(v));
+  }
+  return std::make_shared<float_num>(sum.result());
+}
+
 ext_method math_methods[] = {{.method_name = "sin",
-                              .method_func = math_sin,
                               .method_info = 0,
-                              .method_doc = "sin(x)"},
+                              .method_doc = "sin(x)",
+                              .method_vector_func = math_sin},
                              {.method_name = "sqrt",
-                              .method_func = math_sqrt,
                               .method_info = 0,
-                              .method_doc = "square root of x"},
+                              .method_doc = "square root of x",
+                              .method_vector_func = math_sqrt},
+                             {.method_name = "fsum",
+                              .method_info = 0,
+                              .method_doc = "exact sum of the values",
+                              .method_vector_func = math_fsum},
                              {.method_func = nullptr, .method_info = 0}};
 
 #ifdef __cplusplus
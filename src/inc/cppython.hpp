@@ -11,6 +11,9 @@ struct ext_method {
   native_function_t *method_func;
   int method_info;
   std::string_view method_doc;
+  /// @brief set instead of method_func for a function taking its arguments
+  /// in place, see vector_function_t
+  vector_function_t *method_vector_func{nullptr};
 };
 
 using init_func = ext_method *();
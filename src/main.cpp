@@ -1,20 +1,38 @@
 #include "code/pyc_parser.hpp"
 #include "runtime/interpreter.hpp"
+#include "runtime/profiler.hpp"
 #include "runtime/static_value.hpp"
 
 #include <filesystem>
+#include <optional>
 #include <print>
+#include <string>
+#include <string_view>
 
 int main(int argc, char **argv) {
-  if (argc <= 1) {
+  // cppython [--profile[=output]] file.pyc
+  std::optional<std::string> profile_path;
+  const char *file_name = nullptr;
+  for (int i = 1; i < argc; i++) {
+    std::string_view arg{argv[i]};
+    if (arg == "--profile") {
+      profile_path = "cppython.folded";
+    } else if (arg.starts_with("--profile=")) {
+      profile_path = arg.substr(arg.find('=') + 1);
+    } else {
+      file_name = argv[i];
+    }
+  }
+
+  if (file_name == nullptr) {
     std::println("cppython need a parameter: filename");
     return 0;
   }
 
-  std::filesystem::path file{argv[1]};
+  std::filesystem::path file{file_name};
 
   if (!std::filesystem::exists(file)) {
-    std::println("{} doesn't exist");
+    std::println("{} doesn't exist", file_name);
     return -1;
   }
 
@@ -25,9 +43,18 @@ int main(int argc, char **argv) {
 
   cppython::static_value::create();
 
-  cppython::pyc_parser parser{argv[1]};
+  cppython::pyc_parser parser{file_name};
   auto code = parser.parse();
 
+  auto profiler = cppython::profiler::get_instance();
+  if (profile_path && profiler->start(*profile_path)) {
+    profiler->keep(code);
+  } else if (profile_path) {
+    std::println("cppython can't profile on this platform");
+  }
+
   cppython::interpreter::get_instance()->run(code);
+
+  profiler->stop();
   return 0;
 }
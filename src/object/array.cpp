@@ -0,0 +1,316 @@
+#include "object/array.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/float.hpp"
+#include "object/integer.hpp"
+#include "object/list.hpp"
+#include "object/slice.hpp"
+#include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/static_value.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <string_view>
+#include <type_traits>
+
+using namespace cppython;
+
+template <typename T>
+static T unbox(const std::shared_ptr<object> &x) {
+  if (x->get_klass() == integer_klass::get_instance()) {
+    return static_cast<T>(std::static_pointer_cast<integer>(x)->get_value());
+  }
+  assert(x->get_klass() == float_klass::get_instance());
+  return static_cast<T>(std::static_pointer_cast<float_num>(x)->get_value());
+}
+
+template <typename T>
+static std::shared_ptr<object> box(T x) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::make_shared<float_num>(static_cast<double>(x));
+  } else {
+    return std::make_shared<integer>(static_cast<int>(x));
+  }
+}
+
+void array_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("append"),
+              std::make_shared<function>(array::array_append));
+  map->insert(std::make_shared<string>("tolist"),
+              std::make_shared<function>(array::array_tolist));
+  set_dict(map);
+
+  set_name("array");
+  std::make_shared<type>()->set_own_klass(this);
+
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<string> array_klass::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto array_obj = std::static_pointer_cast<array>(obj);
+
+  std::string result = std::format("array('{}'", array_obj->get_type_code());
+  if (array_obj->size() > 0) {
+    result += ", [";
+    for (size_t i{0}; i < array_obj->size(); ++i) {
+      if (i != 0) {
+        result += ", ";
+      }
+      result += array_obj->at(i)->repr()->get_value();
+    }
+    result += "]";
+  }
+  result += ")";
+  return std::make_shared<string>(std::move(result));
+}
+
+std::shared_ptr<object> array_klass::add(std::shared_ptr<object> x,
+                                         std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto array_x = std::static_pointer_cast<array>(x);
+  assert(y && y->get_klass() == this);
+  auto array_y = std::static_pointer_cast<array>(y);
+  assert(array_x->get_type_code() == array_y->get_type_code());
+
+  auto result = std::make_shared<array>(array_x->get_type_code());
+  std::visit(
+      [&](const auto &lhs) {
+        using vector_type = std::decay_t<decltype(lhs)>;
+        const auto &rhs = std::get<vector_type>(array_y->get_value());
+        auto &dst = std::get<vector_type>(result->get_value());
+        dst.reserve(lhs.size() + rhs.size());
+        dst.insert(dst.end(), lhs.begin(), lhs.end());
+        dst.insert(dst.end(), rhs.begin(), rhs.end());
+      },
+      array_x->get_value());
+  return result;
+}
+
+std::shared_ptr<object> array_klass::mul(std::shared_ptr<object> x,
+                                         std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto array_x = std::static_pointer_cast<array>(x);
+  assert(y && y->get_klass() == integer_klass::get_instance());
+  auto n = std::max(std::static_pointer_cast<integer>(y)->get_value(), 0);
+
+  auto result = std::make_shared<array>(array_x->get_type_code());
+  std::visit(
+      [&](const auto &src) {
+        using vector_type = std::decay_t<decltype(src)>;
+        auto &dst = std::get<vector_type>(result->get_value());
+        dst.reserve(src.size() * n);
+        for (int i{0}; i < n; ++i) {
+          dst.insert(dst.end(), src.begin(), src.end());
+        }
+      },
+      array_x->get_value());
+  return result;
+}
+
+std::shared_ptr<object> array_klass::subscr(std::shared_ptr<object> x,
+                                            std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto array_obj = std::static_pointer_cast<array>(x);
+  auto index = sequence_index("array", y, array_obj->size());
+  if (!index) {
+    return nullptr;
+  }
+  return array_obj->at(*index);
+}
+
+void array_klass::store_subscr(std::shared_ptr<object> x,
+                               std::shared_ptr<object> y,
+                               std::shared_ptr<object> z) {
+  assert(x && x->get_klass() == this);
+  auto array_obj = std::static_pointer_cast<array>(x);
+  auto index =
+      sequence_index("array", y, array_obj->size(), "assignment index");
+  if (!index) {
+    return;
+  }
+
+  if (z->get_klass() != integer_klass::get_instance() &&
+      z->get_klass() != float_klass::get_instance()) {
+    raise_error(exception_klass::type_error,
+                std::format("must be real number, not {}",
+                            z->get_klass()->get_name()));
+    return;
+  }
+  array_obj->set_at(*index, z);
+}
+
+std::shared_ptr<object> array_klass::iter(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::make_shared<array_iterator>(std::static_pointer_cast<array>(x));
+}
+
+std::shared_ptr<object> array_klass::len(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto array_obj = std::static_pointer_cast<array>(x);
+  return std::make_shared<integer>(static_cast<int>(array_obj->size()));
+}
+
+std::shared_ptr<object> array_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  assert(args && args->size() >= 1);
+
+  auto code = args->at(0);
+  assert(code && code->get_klass() == string_klass::get_instance());
+  auto code_str = std::static_pointer_cast<string>(code);
+  assert(code_str->size() == 1 && array::is_valid_type_code(code_str->at(0)));
+
+  auto result = std::make_shared<array>(code_str->at(0));
+  if (args->size() < 2) {
+    return result;
+  }
+
+  auto init = args->at(1);
+  if (init->get_klass() == list_klass::get_instance()) {
+    auto list_obj = std::static_pointer_cast<list>(init);
+    result->reserve(list_obj->size());
+    for (const auto &e : list_obj->get_value()) {
+      result->append(e);
+    }
+    return result;
+  }
+
+  auto iter = init->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    result->append(v);
+  }
+  return result;
+}
+
+array::array(char type_code) : type_code{type_code} {
+  switch (type_code) {
+  case 'b':
+    value.emplace<std::vector<signed char>>();
+    break;
+  case 'h':
+    value.emplace<std::vector<short>>();
+    break;
+  case 'i':
+    value.emplace<std::vector<int>>();
+    break;
+  case 'l':
+    value.emplace<std::vector<long>>();
+    break;
+  case 'q':
+    value.emplace<std::vector<long long>>();
+    break;
+  case 'f':
+    value.emplace<std::vector<float>>();
+    break;
+  case 'd':
+    value.emplace<std::vector<double>>();
+    break;
+  default:
+    assert(false && "bad typecode");
+  }
+  set_klass(array_klass::get_instance());
+}
+
+bool array::is_valid_type_code(char type_code) {
+  return std::string_view{"bhilqfd"}.find(type_code) != std::string_view::npos;
+}
+
+size_t array::size() const {
+  return std::visit([](const auto &v) { return v.size(); }, value);
+}
+
+size_t array::item_size() const {
+  return std::visit(
+      [](const auto &v) {
+        return sizeof(typename std::decay_t<decltype(v)>::value_type);
+      },
+      value);
+}
+
+void array::reserve(size_t cnt) {
+  std::visit([cnt](auto &v) { v.reserve(cnt); }, value);
+}
+
+std::shared_ptr<object> array::at(size_t pos) {
+  return std::visit([pos](const auto &v) { return box(v.at(pos)); }, value);
+}
+
+void array::set_at(size_t pos, const std::shared_ptr<object> &x) {
+  std::visit(
+      [&](auto &v) {
+        using value_type = typename std::decay_t<decltype(v)>::value_type;
+        v.at(pos) = unbox<value_type>(x);
+      },
+      value);
+}
+
+void array::append(const std::shared_ptr<object> &x) {
+  std::visit(
+      [&](auto &v) {
+        using value_type = typename std::decay_t<decltype(v)>::value_type;
+        v.push_back(unbox<value_type>(x));
+      },
+      value);
+}
+
+buffer_view array::get_buffer() {
+  return std::visit(
+      [this](auto &v) {
+        return buffer_view{.buf = v.data(),
+                           .len = v.size(),
+                           .item_size = item_size(),
+                           .format = type_code};
+      },
+      value);
+}
+
+std::shared_ptr<object> array::array_append(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == array_klass::get_instance());
+  auto array_obj = std::static_pointer_cast<array>(arg_0);
+
+  array_obj->append(args->at(1));
+  return static_value::none_value;
+}
+
+std::shared_ptr<object> array::array_tolist(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == array_klass::get_instance());
+  auto array_obj = std::static_pointer_cast<array>(arg_0);
+
+  auto result = std::make_shared<list>();
+  result->get_value().reserve(array_obj->size());
+  for (size_t i{0}; i < array_obj->size(); ++i) {
+    result->append(array_obj->at(i));
+  }
+  return result;
+}
+
+array_iterator_klass::array_iterator_klass() {
+  set_name("arrayiterator");
+  set_dict(std::make_shared<dict>());
+}
+
+std::shared_ptr<object> array_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto iter_obj = std::static_pointer_cast<array_iterator>(x);
+
+  auto arr = iter_obj->get_array();
+  auto iter_cnt = iter_obj->get_iter_cnt();
+  if (iter_cnt < arr->size()) {
+    iter_obj->inc_cnt();
+    return arr->at(iter_cnt);
+  }
+  return nullptr;
+}
+
+array_iterator::array_iterator(std::shared_ptr<array> owner) : arr{owner} {
+  set_klass(array_iterator_klass::get_instance());
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "object/buffer.hpp"
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <variant>
+#include <vector>
+
+namespace cppython {
+
+class array_klass : public klass, public singleton<array_klass> {
+  friend class singleton<array_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> add(std::shared_ptr<object> x,
+                              std::shared_ptr<object> y) override;
+  std::shared_ptr<object> mul(std::shared_ptr<object> x,
+                              std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> subscr(std::shared_ptr<object> x,
+                                 std::shared_ptr<object> y) override;
+  void store_subscr(std::shared_ptr<object> x, std::shared_ptr<object> y,
+                    std::shared_ptr<object> z) override;
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
+  std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+
+  /// @brief array(typecode[, iterable])
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+/// @brief homogeneous sequence of unboxed numbers, the items are kept in one
+/// contiguous block of memory and only boxed when they are read by python code
+class array : public object {
+public:
+  using storage_type =
+      std::variant<std::vector<signed char>, std::vector<short>,
+                   std::vector<int>, std::vector<long>, std::vector<long long>,
+                   std::vector<float>, std::vector<double>>;
+
+  array(char type_code);
+
+  [[nodiscard]] static bool is_valid_type_code(char type_code);
+
+  char get_type_code() const { return type_code; }
+  auto &get_value() { return value; }
+
+  size_t size() const;
+  size_t item_size() const;
+  void reserve(size_t cnt);
+
+  std::shared_ptr<object> at(size_t pos);
+  void set_at(size_t pos, const std::shared_ptr<object> &x);
+  void append(const std::shared_ptr<object> &x);
+
+  /// @brief zero-copy view of the items, used by native extensions
+  buffer_view get_buffer();
+
+  static std::shared_ptr<object>
+  array_append(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+  static std::shared_ptr<object>
+  array_tolist(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+private:
+  char type_code;
+  storage_type value;
+};
+
+class array_iterator_klass : public klass,
+                             public singleton<array_iterator_klass> {
+  friend class singleton<array_iterator_klass>;
+
+private:
+  array_iterator_klass();
+
+public:
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+};
+
+class array_iterator : public object {
+public:
+  array_iterator(std::shared_ptr<array> owner);
+
+  std::shared_ptr<array> get_array() { return arr; }
+  size_t get_iter_cnt() { return iter_cnt; }
+  void inc_cnt() { iter_cnt++; }
+
+private:
+  std::shared_ptr<array> arr;
+  size_t iter_cnt{0};
+};
+
+} // namespace cppython
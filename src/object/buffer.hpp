@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cppython {
+
+/// @brief a raw view of the contiguous storage owned by an object, the view is
+/// valid until the owner is resized or destroyed
+struct buffer_view {
+  void *buf;
+  size_t len; // number of items
+  size_t item_size;
+  char format; // type code of the items, same as array type codes
+};
+
+} // namespace cppython
@@ -0,0 +1,168 @@
+#include "object/bytearray.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/integer.hpp"
+#include "object/slice.hpp"
+#include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/static_value.hpp"
+
+#include <cassert>
+#include <format>
+
+using namespace cppython;
+
+void bytearray_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("decode"),
+              std::make_shared<function>(bytearray::bytearray_decode));
+  set_dict(map);
+
+  set_name("bytearray");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<string> bytearray_klass::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto bytes_obj = std::static_pointer_cast<bytearray>(obj);
+
+  std::string result = "bytearray(b'";
+  for (unsigned char c : bytes_obj->view()) {
+    switch (c) {
+    case '\n':
+      result += "\\n";
+      break;
+    case '\r':
+      result += "\\r";
+      break;
+    case '\t':
+      result += "\\t";
+      break;
+    case '\\':
+    case '\'':
+      result += '\\';
+      result += static_cast<char>(c);
+      break;
+    default:
+      if (c < 0x20 || c >= 0x7f) {
+        result += std::format("\\x{:02x}", c);
+      } else {
+        result += static_cast<char>(c);
+      }
+    }
+  }
+  result += "')";
+  return std::make_shared<string>(std::move(result));
+}
+
+std::shared_ptr<object> bytearray_klass::equal(std::shared_ptr<object> x,
+                                               std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  if (y->get_klass() != this) {
+    return static_value::false_value;
+  }
+  return static_value::get_bool_value(
+      std::static_pointer_cast<bytearray>(x)->view() ==
+      std::static_pointer_cast<bytearray>(y)->view());
+}
+
+std::shared_ptr<object> bytearray_klass::subscr(std::shared_ptr<object> x,
+                                                std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto bytes_obj = std::static_pointer_cast<bytearray>(x);
+
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto bytes = bytes_obj->view();
+    auto b = std::static_pointer_cast<slice>(y)->indices(bytes.size());
+    if (!b) {
+      return nullptr;
+    }
+    return bytearray::from_slice(bytes, *b);
+  }
+
+  auto index = sequence_index("bytearray", y, bytes_obj->size());
+  if (!index) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(bytes_obj->data()[*index]);
+}
+
+void bytearray_klass::store_subscr(std::shared_ptr<object> x,
+                                   std::shared_ptr<object> y,
+                                   std::shared_ptr<object> z) {
+  assert(x && x->get_klass() == this);
+  auto bytes_obj = std::static_pointer_cast<bytearray>(x);
+  auto index =
+      sequence_index("bytearray", y, bytes_obj->size(), "assignment index");
+  if (!index) {
+    return;
+  }
+
+  if (z->get_klass() != integer_klass::get_instance()) {
+    raise_error(exception_klass::type_error,
+                std::format("'{}' object cannot be interpreted as an integer",
+                            z->get_klass()->get_name()));
+    return;
+  }
+  auto v = std::static_pointer_cast<integer>(z)->get_value();
+  if (v < 0 || v >= 256) {
+    raise_error(exception_klass::value_error, "byte must be in range(0, 256)");
+    return;
+  }
+  bytes_obj->data()[*index] = static_cast<unsigned char>(v);
+}
+
+std::shared_ptr<object> bytearray_klass::len(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto bytes_obj = std::static_pointer_cast<bytearray>(x);
+  return std::make_shared<integer>(static_cast<int>(bytes_obj->size()));
+}
+
+std::shared_ptr<object> bytearray_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (!args || args->size() == 0) {
+    return std::make_shared<bytearray>();
+  }
+
+  auto arg_0 = args->at(0);
+  if (arg_0->get_klass() == integer_klass::get_instance()) {
+    auto size = std::static_pointer_cast<integer>(arg_0)->get_value();
+    assert(size >= 0);
+    return std::make_shared<bytearray>(static_cast<size_t>(size));
+  }
+
+  assert(arg_0->get_klass() == string_klass::get_instance());
+  return std::make_shared<bytearray>(
+      std::string_view{std::static_pointer_cast<string>(arg_0)->get_value()});
+}
+
+bytearray::bytearray(size_t size) : value(size) {
+  set_klass(bytearray_klass::get_instance());
+}
+
+bytearray::bytearray(std::string_view bytes)
+    : value(bytes.begin(), bytes.end()) {
+  set_klass(bytearray_klass::get_instance());
+}
+
+std::shared_ptr<bytearray> bytearray::from_slice(std::string_view src,
+                                                 const slice_bounds &b) {
+  if (b.step == 1) {
+    return std::make_shared<bytearray>(src.substr(b.start, b.length));
+  }
+  auto result = std::make_shared<bytearray>(b.length);
+  for (size_t i = 0; i < b.length; i++) {
+    result->data()[i] = static_cast<unsigned char>(src[b.start + i * b.step]);
+  }
+  return result;
+}
+
+std::shared_ptr<object> bytearray::bytearray_decode(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == bytearray_klass::get_instance());
+  return std::make_shared<string>(
+      std::static_pointer_cast<bytearray>(arg_0)->view());
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "object/buffer.hpp"
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+struct slice_bounds;
+
+class bytearray_klass : public klass, public singleton<bytearray_klass> {
+  friend class singleton<bytearray_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> equal(std::shared_ptr<object> x,
+                                std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> subscr(std::shared_ptr<object> x,
+                                 std::shared_ptr<object> y) override;
+  void store_subscr(std::shared_ptr<object> x, std::shared_ptr<object> y,
+                    std::shared_ptr<object> z) override;
+
+  std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+
+  /// @brief bytearray(), bytearray(size) or bytearray(str)
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+/// @brief mutable contiguous bytes, the target of file.readinto
+class bytearray : public object {
+public:
+  bytearray(size_t size = 0);
+  bytearray(std::string_view bytes);
+
+  size_t size() const { return value.size(); }
+  unsigned char *data() { return value.data(); }
+  std::string_view view() const {
+    return {reinterpret_cast<const char *>(value.data()), value.size()};
+  }
+  void resize(size_t size) { value.resize(size); }
+
+  /// @brief a new bytearray of the bytes of src selected by b
+  static std::shared_ptr<bytearray> from_slice(std::string_view src,
+                                               const slice_bounds &b);
+
+  /// @brief zero-copy view of the bytes, format 'B'
+  buffer_view get_buffer() {
+    return {.buf = value.data(), .len = value.size(), .item_size = 1,
+            .format = 'B'};
+  }
+
+  static std::shared_ptr<object>
+  bytearray_decode(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+private:
+  std::vector<unsigned char> value;
+};
+
+} // namespace cppython
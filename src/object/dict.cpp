@@ -1,9 +1,11 @@
 #include "object/dict.hpp"
+#include "object/exception.hpp"
 #include "object/integer.hpp"
 #include "object/list.hpp"
 #include "object/string.hpp"
 #include "object/tuple.hpp"
 #include "runtime/function.hpp"
+#include "runtime/interpreter.hpp"
 #include "runtime/static_value.hpp"
 #include "runtime/string_table.hpp"
 
@@ -69,7 +71,11 @@ std::shared_ptr<object> dict_klass::subscr(std::shared_ptr<object> x,
   assert(x && x->get_klass() == this);
   auto map_obj = std::static_pointer_cast<dict>(x);
 
-  return map_obj->at(y);
+  auto v = map_obj->get(y, value_equal{});
+  if (!v) {
+    return raise_error(exception_klass::key_error, y);
+  }
+  return *v;
 }
 
 void dict_klass::store_subscr(std::shared_ptr<object> x,
@@ -78,7 +84,13 @@ void dict_klass::store_subscr(std::shared_ptr<object> x,
   assert(x && x->get_klass() == this);
   auto map_obj = std::static_pointer_cast<dict>(x);
 
-  map_obj->insert(y, z);
+  if (dict::check_key(y)) {
+    map_obj->insert(y, z);
+  }
+}
+
+size_t dict_klass::hash(std::shared_ptr<object> x) {
+  return unhashable(x);
 }
 
 std::shared_ptr<object> dict_klass::iter(std::shared_ptr<object> x) {
@@ -90,6 +102,10 @@ void dict_klass::del_subscr(std::shared_ptr<object> x,
                             std::shared_ptr<object> y) {
   assert(x && x->get_klass() == this);
   auto map_obj = std::static_pointer_cast<dict>(x);
+  if (!map_obj->has_key(y)) {
+    raise_error(exception_klass::key_error, y);
+    return;
+  }
   map_obj->remove(y);
 }
 
@@ -116,6 +132,24 @@ bool dict::has_key(std::shared_ptr<object> k) {
   return iter != value.end();
 }
 
+bool dict::check_key(const std::shared_ptr<object> &k) {
+  k->hash();
+  return !interpreter::get_instance()->has_pending_exception();
+}
+
+std::shared_ptr<dict>
+dict::pop_keyword_args(std::vector<std::shared_ptr<object>> &args) {
+  if (args.empty() || args.back()->get_klass() != dict_klass::get_instance()) {
+    return nullptr;
+  }
+  auto kwargs = std::static_pointer_cast<dict>(args.back());
+  if (!kwargs->is_keyword_args()) {
+    return nullptr;
+  }
+  args.pop_back();
+  return kwargs;
+}
+
 std::shared_ptr<object> dict::at(std::shared_ptr<object> k) {
   return get(k, value_equal{}).value_or(static_value::none_value);
 }
@@ -197,10 +231,7 @@ dict::dict_items(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
   auto items = std::make_shared<list>();
 
   for (const auto &[k, v] : dict_obj->get_value()) {
-    auto k_v = std::make_shared<tuple>();
-    k_v->append(k);
-    k_v->append(v);
-    items->append(k_v);
+    items->append(tuple::create({k, v}));
   }
 
   return items;
@@ -30,6 +30,8 @@ public:
   std::shared_ptr<object> getattr(std::shared_ptr<object> x,
                                   std::shared_ptr<string> y);
 
+  size_t hash(std::shared_ptr<object> x) override;
+
   std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
 
   std::shared_ptr<object> allocate_instance(
@@ -48,8 +50,22 @@ public:
 
   auto size() { return value.size(); }
 
+  /// @brief set on the dict CALL_FUNCTION_KW builds, so native functions can
+  /// tell keyword arguments from a trailing positional dict
+  void set_keyword_args(bool x) { keyword_args = x; }
+  [[nodiscard]] bool is_keyword_args() const { return keyword_args; }
+
+  /// @brief removes and returns the keyword arguments at the end of args,
+  /// nullptr when the call had none
+  static std::shared_ptr<dict>
+  pop_keyword_args(std::vector<std::shared_ptr<object>> &args);
+
   bool has_key(std::shared_ptr<object> k);
 
+  /// @brief keys are found by equality, so a key is only hashed here, to
+  /// raise TypeError for an unhashable one. false when it raised.
+  static bool check_key(const std::shared_ptr<object> &k);
+
   template <typename PredicateOperation>
     requires std::predicate<PredicateOperation, const std::shared_ptr<object> &,
                             const std::shared_ptr<object> &>
@@ -84,6 +100,8 @@ public:
     }
   }
 
+  /// @brief the value of k, None when k is missing. d[k] raises KeyError
+  /// instead, through dict_klass::subscr.
   std::shared_ptr<object> at(std::shared_ptr<object> k);
   std::shared_ptr<object> remove(std::shared_ptr<object> k);
 
@@ -100,6 +118,7 @@ public:
 
 private:
   std::unordered_map<std::shared_ptr<object>, std::shared_ptr<object>> value;
+  bool keyword_args{false};
 };
 
 class dict_iterator_klass : public klass,
@@ -0,0 +1,212 @@
+#include "object/exception.hpp"
+#include "object/dict.hpp"
+#include "object/list.hpp"
+#include "object/string.hpp"
+#include "object/tuple.hpp"
+#include "runtime/interpreter.hpp"
+#include "runtime/static_value.hpp"
+#include "runtime/string_table.hpp"
+
+#include <cassert>
+#include <format>
+
+using namespace cppython;
+
+static std::vector<exception_klass *> builtin_exceptions;
+
+exception_klass::exception_klass(std::string_view name,
+                                  exception_klass *base) {
+  auto map = std::make_shared<dict>();
+  if (base == nullptr) {
+    // inherited through the mro by every exception, user classes included
+    map->insert(string_table::get_instance()->init_str,
+                std::make_shared<function>(exception_object::exception_init));
+    map->insert(string_table::get_instance()->repr_str,
+                std::make_shared<function>(exception_object::exception_repr));
+    map->insert(string_table::get_instance()->str_str,
+                std::make_shared<function>(exception_object::exception_str));
+  }
+  set_dict(map);
+
+  set_name(name);
+  std::make_shared<type>()->set_own_klass(this);
+  if (base == nullptr) {
+    add_super(object_klass::get_instance());
+  } else {
+    add_super(base);
+  }
+  order_supers();
+}
+
+void exception_klass::create_builtins() {
+  auto make = [](std::string_view name, exception_klass *base) {
+    return builtin_exceptions.emplace_back(new exception_klass(name, base));
+  };
+
+  base_exception = make("BaseException", nullptr);
+  generator_exit = make("GeneratorExit", base_exception);
+  exception = make("Exception", base_exception);
+  stop_iteration = make("StopIteration", exception);
+  arithmetic_error = make("ArithmeticError", exception);
+  overflow_error = make("OverflowError", arithmetic_error);
+  zero_division_error = make("ZeroDivisionError", arithmetic_error);
+  assertion_error = make("AssertionError", exception);
+  attribute_error = make("AttributeError", exception);
+  lookup_error = make("LookupError", exception);
+  index_error = make("IndexError", lookup_error);
+  key_error = make("KeyError", lookup_error);
+  name_error = make("NameError", exception);
+  unbound_local_error = make("UnboundLocalError", name_error);
+  os_error = make("OSError", exception);
+  runtime_error = make("RuntimeError", exception);
+  not_implemented_error = make("NotImplementedError", runtime_error);
+  type_error = make("TypeError", exception);
+  value_error = make("ValueError", exception);
+}
+
+const std::vector<exception_klass *> &exception_klass::builtins() {
+  return builtin_exceptions;
+}
+
+bool exception_klass::is_exception(const std::shared_ptr<object> &x) {
+  // a class is not in its own mro
+  auto k = x->get_klass();
+  return k == base_exception ||
+         (k->get_mro() != nullptr &&
+          k->get_mro()->has_pointer(base_exception->get_type_object()));
+}
+
+std::shared_ptr<string> exception_klass::repr(std::shared_ptr<object> obj) {
+  return std::static_pointer_cast<string>(
+      exception_object::exception_repr(vector_args_t{&obj, 1}));
+}
+
+std::shared_ptr<string> exception_klass::str(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  return std::static_pointer_cast<exception_object>(obj)->message();
+}
+
+std::shared_ptr<object> exception_klass::getattr(std::shared_ptr<object> x,
+                                                 std::shared_ptr<object> y) {
+  if (value_equal{}(y, string_table::get_instance()->args_str)) {
+    return std::static_pointer_cast<exception_object>(x)->get_args();
+  }
+  return klass::getattr(x, y);
+}
+
+std::shared_ptr<object> exception_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (!args || args->empty()) {
+    return std::make_shared<exception_object>(this);
+  }
+  if (args->size() == 1) {
+    return std::make_shared<exception_object>(this, args->front());
+  }
+  auto e = std::make_shared<exception_object>(this);
+  e->set_args(tuple::create(*args));
+  return e;
+}
+
+std::shared_ptr<object> exception_klass::shared_instance() {
+  if (!shared) {
+    shared = std::make_shared<exception_object>(this);
+  }
+  return shared;
+}
+
+exception_object::exception_object(klass *k, std::shared_ptr<object> arg)
+    : arg{std::move(arg)} {
+  set_klass(k);
+}
+
+std::shared_ptr<tuple> exception_object::get_args() {
+  if (!args) {
+    args = arg ? tuple::create({arg}) : tuple::create(size_t{0});
+    arg = nullptr;
+  }
+  return args;
+}
+
+void exception_object::set_args(std::shared_ptr<tuple> x) {
+  args = std::move(x);
+  arg = nullptr;
+}
+
+std::shared_ptr<string> exception_object::message() {
+  auto single = arg;
+  if (!single && args) {
+    if (args->size() > 1) {
+      return args->repr();
+    }
+    if (args->size() == 1) {
+      single = args->at(0);
+    }
+  }
+  if (!single) {
+    return std::make_shared<string>("");
+  }
+  // a missing key is shown as it was written
+  if (get_klass() == exception_klass::key_error) {
+    return single->repr();
+  }
+  return single->str();
+}
+
+std::shared_ptr<string> exception_object::describe() {
+  auto name = get_klass()->get_name();
+  auto msg = str();
+  if (msg->size() == 0) {
+    return std::make_shared<string>(name);
+  }
+  return std::make_shared<string>(
+      std::format("{}: {}", name, msg->get_value()));
+}
+
+/// @brief the exception receiver of a BaseException method
+static std::shared_ptr<exception_object> self_exception(vector_args_t args) {
+  assert(!args.empty() && exception_klass::is_exception(args[0]));
+  return std::static_pointer_cast<exception_object>(args[0]);
+}
+
+std::shared_ptr<object> exception_object::exception_init(vector_args_t args) {
+  auto self = self_exception(args);
+  auto tpl = tuple::create(args.subspan(1));
+  self->set_args(tpl);
+  if (dynamic_cast<exception_klass *>(self->get_klass()) == nullptr) {
+    // instances of user classes look attributes up in their dict
+    self->setattr(string_table::get_instance()->args_str, tpl);
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object> exception_object::exception_repr(vector_args_t args) {
+  auto self = self_exception(args);
+  auto name = self->get_klass()->get_name();
+  if (self->arg) {
+    return std::make_shared<string>(
+        std::format("{}({})", name, self->arg->repr()->get_value()));
+  }
+  auto tpl = self->get_args();
+  if (tpl->size() == 1) {
+    return std::make_shared<string>(
+        std::format("{}({})", name, tpl->at(0)->repr()->get_value()));
+  }
+  return std::make_shared<string>(name + tpl->repr()->get_value());
+}
+
+std::shared_ptr<object> exception_object::exception_str(vector_args_t args) {
+  return self_exception(args)->message();
+}
+
+std::shared_ptr<object> cppython::raise_error(exception_klass *type,
+                                              std::shared_ptr<object> arg) {
+  interpreter::get_instance()->raise(
+      std::make_shared<exception_object>(type, std::move(arg)));
+  return nullptr;
+}
+
+std::shared_ptr<object> cppython::raise_error(exception_klass *type,
+                                              std::string_view message) {
+  return raise_error(type, std::make_shared<string>(message));
+}
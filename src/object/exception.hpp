@@ -0,0 +1,97 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "runtime/function.hpp"
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+class tuple;
+
+/// @brief the class of one built-in exception type. Unlike other klasses
+/// there is one instance per type of the BaseException tree, created by
+/// create_builtins().
+class exception_klass : public klass {
+public:
+  exception_klass(std::string_view name, exception_klass *base);
+
+  /// @brief creates the built-in exception types, in base first order
+  static void create_builtins();
+  static const std::vector<exception_klass *> &builtins();
+  /// @brief true for instances of BaseException and its subclasses
+  static bool is_exception(const std::shared_ptr<object> &x);
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+  std::shared_ptr<string> str(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> getattr(std::shared_ptr<object> x,
+                                  std::shared_ptr<object> y) override;
+
+  /// @brief E(*args), no interpreted __init__ runs
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+
+  /// @brief an instance without arguments shared by every raise of the
+  /// type, for exceptions used as signals
+  std::shared_ptr<object> shared_instance();
+
+  static inline exception_klass *base_exception{nullptr};
+  static inline exception_klass *generator_exit{nullptr};
+  static inline exception_klass *exception{nullptr};
+  static inline exception_klass *stop_iteration{nullptr};
+  static inline exception_klass *arithmetic_error{nullptr};
+  static inline exception_klass *overflow_error{nullptr};
+  static inline exception_klass *zero_division_error{nullptr};
+  static inline exception_klass *assertion_error{nullptr};
+  static inline exception_klass *attribute_error{nullptr};
+  static inline exception_klass *lookup_error{nullptr};
+  static inline exception_klass *index_error{nullptr};
+  static inline exception_klass *key_error{nullptr};
+  static inline exception_klass *name_error{nullptr};
+  static inline exception_klass *unbound_local_error{nullptr};
+  static inline exception_klass *os_error{nullptr};
+  static inline exception_klass *runtime_error{nullptr};
+  static inline exception_klass *not_implemented_error{nullptr};
+  static inline exception_klass *type_error{nullptr};
+  static inline exception_klass *value_error{nullptr};
+
+private:
+  std::shared_ptr<object> shared;
+};
+
+/// @brief an instance of an exception type. A native raise keeps its one
+/// argument as it is, the args tuple is only built when asked for.
+class exception_object : public object {
+public:
+  explicit exception_object(klass *k, std::shared_ptr<object> arg = nullptr);
+
+  std::shared_ptr<tuple> get_args();
+  void set_args(std::shared_ptr<tuple> x);
+
+  /// @brief str(e): empty, the single argument, or the args tuple
+  std::shared_ptr<string> message();
+  /// @brief the last line of a traceback, "KeyError: 'x'"
+  std::shared_ptr<string> describe();
+
+  static std::shared_ptr<object> exception_init(vector_args_t args);
+  static std::shared_ptr<object> exception_repr(vector_args_t args);
+  static std::shared_ptr<object> exception_str(vector_args_t args);
+
+private:
+  std::shared_ptr<tuple> args;
+  std::shared_ptr<object> arg;
+};
+
+/// @brief raises type(arg) from native code. Returns nullptr, the result of
+/// the failed operation, which the interpreter unwinds from.
+std::shared_ptr<object> raise_error(exception_klass *type,
+                                    std::shared_ptr<object> arg);
+std::shared_ptr<object> raise_error(exception_klass *type,
+                                    std::string_view message);
+
+} // namespace cppython
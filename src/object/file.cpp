@@ -0,0 +1,479 @@
+#include "object/file.hpp"
+#include "object/array.hpp"
+#include "object/bytearray.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/integer.hpp"
+#include "object/list.hpp"
+#include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/static_value.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace cppython;
+
+// thin layer over the raw descriptor calls of each platform
+namespace {
+#ifdef _WIN32
+constexpr int open_read = _O_RDONLY;
+constexpr int open_write = _O_WRONLY;
+constexpr int open_read_write = _O_RDWR;
+constexpr int open_create = _O_CREAT;
+constexpr int open_truncate = _O_TRUNC;
+constexpr int open_append = _O_APPEND;
+constexpr int open_exclusive = _O_EXCL;
+
+int sys_open(const char *path, int flags) {
+  return ::_open(path, flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+long long sys_read(int fd, void *buf, size_t n) {
+  return ::_read(fd, buf, static_cast<unsigned>(std::min<size_t>(n, 1 << 30)));
+}
+long long sys_write(int fd, const void *buf, size_t n) {
+  return ::_write(fd, buf, static_cast<unsigned>(std::min<size_t>(n, 1 << 30)));
+}
+void sys_seek_back(int fd, size_t n) {
+  ::_lseeki64(fd, -static_cast<long long>(n), SEEK_CUR);
+}
+void sys_close(int fd) { ::_close(fd); }
+#else
+constexpr int open_read = O_RDONLY;
+constexpr int open_write = O_WRONLY;
+constexpr int open_read_write = O_RDWR;
+constexpr int open_create = O_CREAT;
+constexpr int open_truncate = O_TRUNC;
+constexpr int open_append = O_APPEND;
+constexpr int open_exclusive = O_EXCL;
+
+int sys_open(const char *path, int flags) {
+  return ::open(path, flags | O_CLOEXEC, 0666);
+}
+long long sys_read(int fd, void *buf, size_t n) { return ::read(fd, buf, n); }
+long long sys_write(int fd, const void *buf, size_t n) {
+  return ::write(fd, buf, n);
+}
+void sys_seek_back(int fd, size_t n) {
+  ::lseek(fd, -static_cast<off_t>(n), SEEK_CUR);
+}
+void sys_close(int fd) { ::close(fd); }
+#endif
+} // namespace
+
+/// @brief raises OSError for the errno of the system call that just failed
+static void raise_os_error(std::string_view name = {}) {
+  int error = errno;
+  auto message = std::format("[Errno {}] {}", error, std::strerror(error));
+  if (!name.empty()) {
+    message += std::format(": '{}'", name);
+  }
+  raise_error(exception_klass::os_error, message);
+}
+
+/// @brief text mode reads turn \r\n into \n
+static void translate_newlines(std::string &s) {
+  size_t w = 0;
+  for (size_t r = 0; r < s.size(); r++) {
+    if (s[r] != '\r' || r + 1 == s.size() || s[r + 1] != '\n') {
+      s[w++] = s[r];
+    }
+  }
+  s.resize(w);
+}
+
+void file_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("read"),
+              std::make_shared<function>(file::file_read));
+  map->insert(std::make_shared<string>("readline"),
+              std::make_shared<function>(file::file_readline));
+  map->insert(std::make_shared<string>("readlines"),
+              std::make_shared<function>(file::file_readlines));
+  map->insert(std::make_shared<string>("readinto"),
+              std::make_shared<function>(file::file_readinto));
+  map->insert(std::make_shared<string>("write"),
+              std::make_shared<function>(file::file_write));
+  map->insert(std::make_shared<string>("flush"),
+              std::make_shared<function>(file::file_flush));
+  map->insert(std::make_shared<string>("fileno"),
+              std::make_shared<function>(file::file_fileno));
+  map->insert(std::make_shared<string>("close"),
+              std::make_shared<function>(file::file_close));
+  set_dict(map);
+
+  set_name("file");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<string> file_klass::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto file_obj = std::static_pointer_cast<file>(obj);
+  return std::make_shared<string>(
+      std::format("<{} file '{}', mode '{}'>",
+                  file_obj->is_closed() ? "closed" : "open",
+                  file_obj->get_name(), file_obj->get_mode()));
+}
+
+std::shared_ptr<object> file_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto file_obj = std::static_pointer_cast<file>(x);
+  if (!file_obj->check_readable()) {
+    return nullptr;
+  }
+  auto line = file_obj->read_line();
+  if (line.empty()) {
+    return nullptr;
+  }
+  return file_obj->wrap(std::move(line));
+}
+
+file::file(int fd, std::string name, std::string mode, bool readable,
+           bool writable, bool binary)
+    : fd{fd}, name{std::move(name)}, mode{std::move(mode)}, readable{readable},
+      writable{writable}, binary{binary} {
+  set_klass(file_klass::get_instance());
+  if (readable) {
+    read_buffer.resize(buffer_size);
+  }
+  if (writable) {
+    write_buffer.reserve(buffer_size);
+  }
+}
+
+file::~file() { close(); }
+
+std::shared_ptr<file> file::open(const std::string &name,
+                                 std::string_view mode) {
+  bool readable = false;
+  bool writable = false;
+  int flags = 0;
+
+  switch (mode.empty() ? 'r' : mode.front()) {
+  case 'r':
+    readable = true;
+    break;
+  case 'w':
+    writable = true;
+    flags = open_create | open_truncate;
+    break;
+  case 'a':
+    writable = true;
+    flags = open_create | open_append;
+    break;
+  case 'x':
+    writable = true;
+    flags = open_create | open_exclusive;
+    break;
+  default:
+    raise_error(exception_klass::value_error,
+                std::format("invalid mode: '{}'", mode));
+    return nullptr;
+  }
+
+  if (mode.find('+') != std::string_view::npos) {
+    readable = writable = true;
+  }
+  flags |= readable && writable ? open_read_write
+                                : (readable ? open_read : open_write);
+
+  int fd = sys_open(name.c_str(), flags);
+  if (fd < 0) {
+    raise_os_error(name);
+    return nullptr;
+  }
+  return std::make_shared<file>(fd, name, std::string{mode}, readable,
+                                writable, mode.find('b') != mode.npos);
+}
+
+bool file::check_readable() const {
+  if (is_closed()) {
+    raise_error(exception_klass::value_error, "I/O operation on closed file");
+    return false;
+  }
+  if (!readable) {
+    raise_error(exception_klass::value_error, "not readable");
+    return false;
+  }
+  return true;
+}
+
+bool file::check_writable() const {
+  if (is_closed()) {
+    raise_error(exception_klass::value_error, "I/O operation on closed file");
+    return false;
+  }
+  if (!writable) {
+    raise_error(exception_klass::value_error, "not writable");
+    return false;
+  }
+  return true;
+}
+
+bool file::fill() {
+  flush();
+
+  auto n = sys_read(fd, read_buffer.data(), read_buffer.size());
+  read_pos = 0;
+  read_end = n > 0 ? static_cast<size_t>(n) : 0;
+  return read_end > 0;
+}
+
+void file::drop_read_ahead() {
+  if (read_end > read_pos) {
+    sys_seek_back(fd, read_end - read_pos);
+  }
+  read_pos = read_end = 0;
+}
+
+std::string file::read(long long n) {
+  std::string result;
+  while (n < 0 || result.size() < static_cast<size_t>(n)) {
+    if (read_pos == read_end && !fill()) {
+      break;
+    }
+    size_t take = read_end - read_pos;
+    if (n >= 0) {
+      take = std::min(take, static_cast<size_t>(n) - result.size());
+    }
+    result.append(read_buffer.data() + read_pos, take);
+    read_pos += take;
+  }
+
+  if (!binary) {
+    translate_newlines(result);
+  }
+  return result;
+}
+
+std::string file::read_line() {
+  std::string line;
+  while (true) {
+    if (read_pos == read_end && !fill()) {
+      break;
+    }
+
+    auto begin = read_buffer.data() + read_pos;
+    auto newline =
+        static_cast<char *>(std::memchr(begin, '\n', read_end - read_pos));
+    if (newline != nullptr) {
+      line.append(begin, newline + 1);
+      read_pos += newline + 1 - begin;
+      break;
+    }
+    line.append(begin, read_end - read_pos);
+    read_pos = read_end;
+  }
+
+  if (!binary && line.ends_with("\r\n")) {
+    line.erase(line.size() - 2, 1);
+  }
+  return line;
+}
+
+size_t file::read_into(std::span<unsigned char> dst) {
+  // what is already buffered first, then straight into the caller's memory
+  size_t done = std::min(dst.size(), read_end - read_pos);
+  std::memcpy(dst.data(), read_buffer.data() + read_pos, done);
+  read_pos += done;
+
+  if (done < dst.size()) {
+    flush();
+    while (done < dst.size()) {
+      auto n = sys_read(fd, dst.data() + done, dst.size() - done);
+      if (n <= 0) {
+        break;
+      }
+      done += static_cast<size_t>(n);
+    }
+  }
+  return done;
+}
+
+bool file::write_raw(std::string_view s) {
+  while (!s.empty()) {
+    auto n = sys_write(fd, s.data(), s.size());
+    if (n <= 0) {
+      return false;
+    }
+    s.remove_prefix(static_cast<size_t>(n));
+  }
+  return true;
+}
+
+bool file::write(std::string_view s) {
+  drop_read_ahead();
+
+  if (write_buffer.size() + s.size() > buffer_size && !flush()) {
+    return false;
+  }
+  if (s.size() >= buffer_size) {
+    return write_raw(s);
+  }
+  write_buffer += s;
+  return true;
+}
+
+bool file::flush() {
+  if (write_buffer.empty()) {
+    return true;
+  }
+  // the buffer is dropped even on a failure, as a retry would fail again
+  bool ok = write_raw(write_buffer);
+  write_buffer.clear();
+  return ok;
+}
+
+bool file::close() {
+  if (is_closed()) {
+    return true;
+  }
+  bool ok = flush();
+  sys_close(fd);
+  fd = -1;
+  return ok;
+}
+
+std::shared_ptr<object> file::wrap(std::string data) {
+  if (binary) {
+    return std::make_shared<bytearray>(std::string_view{data});
+  }
+  return std::make_shared<string>(std::move(data));
+}
+
+/// @brief the file receiver of a file method
+static std::shared_ptr<file>
+self_file(const std::vector<std::shared_ptr<object>> &args) {
+  auto arg_0 = args.at(0);
+  assert(arg_0->get_klass() == file_klass::get_instance());
+  return std::static_pointer_cast<file>(arg_0);
+}
+
+std::shared_ptr<object>
+file::file_read(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto file_obj = self_file(*args);
+  if (!file_obj->check_readable()) {
+    return nullptr;
+  }
+  long long n = -1;
+  if (args->size() > 1 && args->at(1) != static_value::none_value) {
+    assert(args->at(1)->get_klass() == integer_klass::get_instance());
+    n = std::static_pointer_cast<integer>(args->at(1))->get_value();
+  }
+  return file_obj->wrap(file_obj->read(n));
+}
+
+std::shared_ptr<object> file::file_readline(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto file_obj = self_file(*args);
+  if (!file_obj->check_readable()) {
+    return nullptr;
+  }
+  return file_obj->wrap(file_obj->read_line());
+}
+
+std::shared_ptr<object> file::file_readlines(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto file_obj = self_file(*args);
+  if (!file_obj->check_readable()) {
+    return nullptr;
+  }
+  auto result = std::make_shared<list>();
+  for (auto line = file_obj->read_line(); !line.empty();
+       line = file_obj->read_line()) {
+    result->append(file_obj->wrap(std::move(line)));
+  }
+  return result;
+}
+
+std::shared_ptr<object> file::file_readinto(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto file_obj = self_file(*args);
+  if (!file_obj->check_readable()) {
+    return nullptr;
+  }
+  auto target = args->at(1);
+
+  buffer_view view;
+  if (target->get_klass() == bytearray_klass::get_instance()) {
+    view = std::static_pointer_cast<bytearray>(target)->get_buffer();
+  } else if (target->get_klass() == array_klass::get_instance()) {
+    view = std::static_pointer_cast<array>(target)->get_buffer();
+  } else {
+    return raise_error(
+        exception_klass::type_error,
+        std::format("readinto() argument must be read-write bytes-like "
+                    "object, not {}",
+                    target->get_klass()->get_name()));
+  }
+
+  auto n = file_obj->read_into(
+      {static_cast<unsigned char *>(view.buf), view.len * view.item_size});
+  return std::make_shared<integer>(static_cast<int>(n));
+}
+
+std::shared_ptr<object>
+file::file_write(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto file_obj = self_file(*args);
+  if (!file_obj->check_writable()) {
+    return nullptr;
+  }
+  auto data = args->at(1);
+
+  std::string_view bytes;
+  if (data->get_klass() == bytearray_klass::get_instance()) {
+    bytes = std::static_pointer_cast<bytearray>(data)->view();
+  } else if (data->get_klass() == string_klass::get_instance()) {
+    bytes = std::static_pointer_cast<string>(data)->get_value();
+  } else {
+    return raise_error(exception_klass::type_error,
+                       std::format("write() argument must be str, not {}",
+                                   data->get_klass()->get_name()));
+  }
+  if (!file_obj->write(bytes)) {
+    raise_os_error();
+    return nullptr;
+  }
+  return std::make_shared<integer>(static_cast<int>(bytes.size()));
+}
+
+std::shared_ptr<object>
+file::file_flush(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (!self_file(*args)->flush()) {
+    raise_os_error();
+    return nullptr;
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object>
+file::file_fileno(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto file_obj = self_file(*args);
+  if (file_obj->is_closed()) {
+    return raise_error(exception_klass::value_error,
+                       "I/O operation on closed file");
+  }
+  return std::make_shared<integer>(file_obj->get_fd());
+}
+
+std::shared_ptr<object>
+file::file_close(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (!self_file(*args)->close()) {
+    raise_os_error();
+    return nullptr;
+  }
+  return static_value::none_value;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+class file_klass : public klass, public singleton<file_klass> {
+  friend class singleton<file_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  /// @brief files iterate over their lines
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+};
+
+/// @brief a file opened by open(), buffered on top of a raw file descriptor.
+/// Reads are served from one fixed size buffer, so lines are cut out of it
+/// without a system call each and a large file streams in constant memory.
+/// Text mode yields str, binary mode yields bytearray.
+class file : public object {
+public:
+  static constexpr size_t buffer_size = 64 * 1024;
+
+  file(int fd, std::string name, std::string mode, bool readable,
+       bool writable, bool binary);
+  ~file();
+
+  /// @brief open(name, mode='r'), raises ValueError for a bad mode and
+  /// OSError when the file can't be opened, and returns nullptr
+  static std::shared_ptr<file> open(const std::string &name,
+                                    std::string_view mode);
+
+  const std::string &get_name() const { return name; }
+  const std::string &get_mode() const { return mode; }
+  bool is_binary() const { return binary; }
+  bool is_closed() const { return fd < 0; }
+  int get_fd() const { return fd; }
+
+  /// @brief up to n bytes, everything left when n is negative
+  std::string read(long long n);
+  /// @brief the next line including its newline, empty at the end of file
+  std::string read_line();
+  /// @brief fills dst, returns the number of bytes read
+  size_t read_into(std::span<unsigned char> dst);
+  /// @brief write, flush and close return false when the underlying write
+  /// fails, with errno telling why
+  bool write(std::string_view s);
+  bool flush();
+  bool close();
+
+  /// @brief raise ValueError and return false unless the file is open in a
+  /// mode that reads, or writes
+  bool check_readable() const;
+  bool check_writable() const;
+
+  static std::shared_ptr<object>
+  file_read(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_readline(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_readlines(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_readinto(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_write(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_flush(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_fileno(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  file_close(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+  /// @brief wraps data read from this file as str or bytearray
+  std::shared_ptr<object> wrap(std::string data);
+
+private:
+  /// @brief refills the read buffer, false at the end of file
+  bool fill();
+  /// @brief hands back read-ahead bytes before switching to writing
+  void drop_read_ahead();
+  bool write_raw(std::string_view s);
+
+private:
+  int fd;
+  std::string name;
+  std::string mode;
+  bool readable;
+  bool writable;
+  bool binary;
+
+  std::vector<char> read_buffer;
+  size_t read_pos{0};
+  size_t read_end{0};
+
+  std::string write_buffer;
+};
+
+} // namespace cppython
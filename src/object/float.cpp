@@ -4,9 +4,11 @@
 #include "runtime/static_value.hpp"
 
 #include <cassert>
+#include <cmath>
 #include <compare>
 #include <concepts>
 #include <functional>
+#include <limits>
 #include <print>
 
 using namespace cppython;
@@ -123,6 +125,18 @@ std::shared_ptr<object> float_klass::mod(std::shared_ptr<object> x,
   return std::make_shared<float_num>(0.);
 }
 
+size_t float_klass::hash(std::shared_ptr<object> x) {
+  assert(x && (x->get_klass() == this));
+  auto v = std::static_pointer_cast<float_num>(x)->get_value();
+
+  // 1.0 == 1, so integral values must hash like the integer
+  if (v == std::trunc(v) && v >= std::numeric_limits<int>::min() &&
+      v <= std::numeric_limits<int>::max()) {
+    return std::hash<int>{}(static_cast<int>(v));
+  }
+  return std::hash<double>{}(v);
+}
+
 std::shared_ptr<object> float_klass::allocate_instance(
     std::shared_ptr<object> obj_type,
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
@@ -54,6 +54,8 @@ public:
   std::shared_ptr<object> mod(std::shared_ptr<object> x,
                               std::shared_ptr<object> y) override;
 
+  size_t hash(std::shared_ptr<object> x) override;
+
   std::shared_ptr<object> allocate_instance(
       std::shared_ptr<object> obj_type,
       std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
@@ -0,0 +1,508 @@
+#include "object/format.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/float.hpp"
+#include "object/integer.hpp"
+#include "object/string.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+
+using namespace cppython;
+
+static bool is_align(char c) {
+  return c == '<' || c == '>' || c == '^' || c == '=';
+}
+
+static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+std::optional<format_spec> format_spec::parse(std::string_view spec) {
+  format_spec r;
+  size_t i = 0;
+  bool has_fill = false;
+
+  if (spec.size() >= 2 && is_align(spec[1])) {
+    r.fill = spec[0];
+    r.align = spec[1];
+    has_fill = true;
+    i = 2;
+  } else if (!spec.empty() && is_align(spec[0])) {
+    r.align = spec[0];
+    i = 1;
+  }
+
+  if (i < spec.size() &&
+      (spec[i] == '+' || spec[i] == '-' || spec[i] == ' ')) {
+    r.sign = spec[i++];
+  }
+  if (i < spec.size() && spec[i] == '#') {
+    r.alternate = true;
+    i++;
+  }
+  if (i < spec.size() && spec[i] == '0') {
+    // zero padding fills with '0' unless a fill was written, an explicit
+    // align is kept
+    if (!has_fill) {
+      r.fill = '0';
+    }
+    if (r.align == '\0') {
+      r.align = '=';
+    }
+    i++;
+  }
+  while (i < spec.size() && is_digit(spec[i])) {
+    r.width = r.width * 10 + (spec[i++] - '0');
+  }
+  if (i < spec.size() && (spec[i] == ',' || spec[i] == '_')) {
+    r.grouping = spec[i++];
+  }
+  if (i < spec.size() && spec[i] == '.') {
+    r.precision = 0;
+    for (i++; i < spec.size() && is_digit(spec[i]); i++) {
+      r.precision = r.precision * 10 + (spec[i] - '0');
+    }
+  }
+  if (i < spec.size()) {
+    r.type = spec[i++];
+  }
+  if (i != spec.size()) {
+    raise_error(exception_klass::value_error, "Invalid format specifier");
+    return std::nullopt;
+  }
+  return r;
+}
+
+/// @brief writes prefix and body into out, padded to the spec's width
+static void pad_to(std::string &out, const format_spec &spec,
+                   std::string_view prefix, std::string_view body,
+                   char default_align) {
+  size_t len = prefix.size() + body.size();
+  size_t padding = spec.width > len ? spec.width - len : 0;
+  char align = spec.align == '\0' ? default_align : spec.align;
+
+  size_t before = 0;
+  switch (align) {
+  case '>':
+    before = padding;
+    break;
+  case '^':
+    before = padding / 2;
+    break;
+  case '=':
+    out += prefix;
+    out.append(padding, spec.fill);
+    out += body;
+    return;
+  default:
+    break;
+  }
+
+  out.append(before, spec.fill);
+  out += prefix;
+  out += body;
+  out.append(padding - before, spec.fill);
+}
+
+/// @brief inserts sep every group digits of digits[0, end)
+static void group_digits(std::string &digits, size_t end, char sep,
+                         size_t group) {
+  for (size_t i = end; i > group; i -= group) {
+    digits.insert(i - group, 1, sep);
+  }
+}
+
+static std::string_view sign_of(bool negative, char sign) {
+  if (negative) {
+    return "-";
+  }
+  return sign == '+' ? "+" : (sign == ' ' ? " " : "");
+}
+
+/// @brief raises ValueError for a format code objects of type_name don't
+/// take, always false
+static bool unknown_format_code(char code, std::string_view type_name) {
+  raise_error(exception_klass::value_error,
+              std::format("Unknown format code '{}' for object of type '{}'",
+                          code, type_name));
+  return false;
+}
+
+static bool format_float_to(std::string &out, double v,
+                            const format_spec &spec,
+                            std::string_view type_name = "float") {
+  std::array<char, 400> buffer;
+  std::chars_format fmt = std::chars_format::general;
+  int precision = spec.precision < 0 ? 6 : spec.precision;
+  bool percent = false;
+
+  switch (spec.type) {
+  case 'f':
+  case 'F':
+    fmt = std::chars_format::fixed;
+    break;
+  case 'e':
+  case 'E':
+    fmt = std::chars_format::scientific;
+    break;
+  case '%':
+    fmt = std::chars_format::fixed;
+    v *= 100;
+    percent = true;
+    break;
+  case 'g':
+  case 'G':
+  case '\0':
+    break;
+  default:
+    return unknown_format_code(spec.type, type_name);
+  }
+
+  bool negative = std::signbit(v);
+  double magnitude = std::fabs(v);
+  std::to_chars_result r;
+  if (spec.type == '\0' && spec.precision < 0) {
+    // no type and no precision means shortest round trip
+    r = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                      magnitude);
+  } else {
+    r = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                      magnitude, fmt, precision);
+  }
+
+  std::string body{buffer.data(), r.ptr};
+  if (spec.type == '\0' && std::isfinite(v) &&
+      body.find_first_of(".en") == std::string::npos) {
+    body += ".0";
+  }
+  if (spec.type == 'F' || spec.type == 'E' || spec.type == 'G') {
+    for (auto &c : body) {
+      c = static_cast<char>(std::toupper(c));
+    }
+  }
+  if (spec.grouping != '\0' && std::isfinite(v)) {
+    group_digits(body, std::min(body.find_first_of(".eE"), body.size()),
+                 spec.grouping, 3);
+  }
+  if (percent) {
+    body += '%';
+  }
+
+  pad_to(out, spec, sign_of(negative, spec.sign), body, '>');
+  return true;
+}
+
+static bool format_int_to(std::string &out, int v, const format_spec &spec) {
+  int base = 10;
+  std::string_view alt_prefix;
+  switch (spec.type) {
+  case '\0':
+  case 'd':
+  case 'n':
+    break;
+  case 'x':
+  case 'X':
+    base = 16;
+    alt_prefix = spec.type == 'x' ? "0x" : "0X";
+    break;
+  case 'o':
+    base = 8;
+    alt_prefix = "0o";
+    break;
+  case 'b':
+    base = 2;
+    alt_prefix = "0b";
+    break;
+  case 'c': {
+    if (spec.sign != '-') {
+      raise_error(exception_klass::value_error,
+                  "Sign not allowed with integer format specifier 'c'");
+      return false;
+    }
+    char c = static_cast<char>(v);
+    pad_to(out, spec, "", std::string_view{&c, 1}, '<');
+    return true;
+  }
+  default:
+    // e, f, g and % format the value as a float
+    return format_float_to(out, v, spec, "int");
+  }
+
+  std::array<char, 40> buffer;
+  auto magnitude = std::llabs(static_cast<long long>(v));
+  auto r = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                         magnitude, base);
+  std::string body{buffer.data(), r.ptr};
+  if (spec.type == 'X') {
+    for (auto &c : body) {
+      c = static_cast<char>(std::toupper(c));
+    }
+  }
+  if (spec.grouping != '\0') {
+    group_digits(body, body.size(), spec.grouping, base == 10 ? 3 : 4);
+  }
+
+  std::string prefix{sign_of(v < 0, spec.sign)};
+  if (spec.alternate) {
+    prefix += alt_prefix;
+  }
+  pad_to(out, spec, prefix, body, '>');
+  return true;
+}
+
+bool cppython::format_value_to(std::string &out,
+                               const std::shared_ptr<object> &v,
+                               std::string_view spec) {
+  auto k = v->get_klass();
+
+  if (spec.empty()) {
+    if (k == string_klass::get_instance()) {
+      out += std::static_pointer_cast<string>(v)->get_value();
+    } else {
+      out += v->str()->get_value();
+    }
+    return true;
+  }
+
+  auto parsed = format_spec::parse(spec);
+  if (!parsed) {
+    return false;
+  }
+  if (k == integer_klass::get_instance()) {
+    return format_int_to(
+        out, std::static_pointer_cast<integer>(v)->get_value(), *parsed);
+  }
+  if (k == float_klass::get_instance()) {
+    return format_float_to(
+        out, std::static_pointer_cast<float_num>(v)->get_value(), *parsed);
+  }
+
+  if (parsed->type != '\0' && parsed->type != 's') {
+    return unknown_format_code(parsed->type, k->get_name());
+  }
+  std::string_view body;
+  std::shared_ptr<string> tmp;
+  if (k == string_klass::get_instance()) {
+    body = std::static_pointer_cast<string>(v)->get_value();
+  } else {
+    tmp = v->str();
+    body = tmp->get_value();
+  }
+  if (parsed->precision >= 0) {
+    body = body.substr(0, parsed->precision);
+  }
+  pad_to(out, *parsed, "", body, '<');
+  return true;
+}
+
+bool cppython::format_value_to(std::string &out,
+                               const std::shared_ptr<object> &v,
+                               char conversion, std::string_view spec) {
+  switch (conversion) {
+  case 'r':
+  case 'a':
+    return format_value_to(out, v->repr(), spec);
+  case 's':
+    return format_value_to(out, v->str(), spec);
+  default:
+    return format_value_to(out, v, spec);
+  }
+}
+
+namespace {
+
+/// @brief how the fields of one format string are numbered, "{}" counts up
+/// and "{0}" names an argument, the two can't be mixed
+struct field_numbering {
+  size_t next{0};
+  bool automatic{false};
+  bool manual{false};
+};
+
+} // namespace
+
+/// @brief resolves field_name (auto numbered, an index or a keyword, then
+/// .attr and [key] parts) to the object it names. nullptr when a part
+/// raised.
+static std::shared_ptr<object>
+resolve_field(std::string_view field_name,
+              const std::vector<std::shared_ptr<object>> &args,
+              const std::shared_ptr<dict> &kwargs, field_numbering &numbering) {
+  auto end = field_name.find_first_of(".[");
+  auto first = field_name.substr(0, end);
+
+  std::shared_ptr<object> obj;
+  if (first.empty() || is_digit(first[0])) {
+    size_t index = 0;
+    if (first.empty()) {
+      if (numbering.manual) {
+        return raise_error(exception_klass::value_error,
+                           "cannot switch from manual field specification "
+                           "to automatic field numbering");
+      }
+      numbering.automatic = true;
+      index = numbering.next++;
+    } else {
+      if (numbering.automatic) {
+        return raise_error(exception_klass::value_error,
+                           "cannot switch from automatic field numbering to "
+                           "manual field specification");
+      }
+      numbering.manual = true;
+      std::from_chars(first.data(), first.data() + first.size(), index);
+    }
+    if (index >= args.size()) {
+      return raise_error(
+          exception_klass::index_error,
+          std::format("Replacement index {} out of range for positional "
+                      "args tuple",
+                      index));
+    }
+    obj = args[index];
+  } else {
+    std::shared_ptr<object> key = std::make_shared<string>(first);
+    auto v = kwargs ? kwargs->get(key, value_equal{}) : std::nullopt;
+    if (!v) {
+      return raise_error(exception_klass::key_error, key);
+    }
+    obj = *v;
+  }
+
+  while (end != std::string_view::npos) {
+    if (field_name[end] == '.') {
+      auto next = field_name.find_first_of(".[", end + 1);
+      obj = obj->getattr(std::make_shared<string>(
+          field_name.substr(end + 1, next - end - 1)));
+      if (obj == nullptr) {
+        return nullptr;
+      }
+      end = next;
+    } else {
+      auto close = field_name.find(']', end);
+      if (close == std::string_view::npos) {
+        return raise_error(exception_klass::value_error,
+                           "Missing ']' in format string");
+      }
+      auto key = field_name.substr(end + 1, close - end - 1);
+      if (!key.empty() && is_digit(key[0])) {
+        int index = 0;
+        std::from_chars(key.data(), key.data() + key.size(), index);
+        obj = obj->subscr(std::make_shared<integer>(index));
+      } else {
+        obj = obj->subscr(std::make_shared<string>(key));
+      }
+      if (obj == nullptr) {
+        return nullptr;
+      }
+      end = close + 1 < field_name.size() ? close + 1 : std::string_view::npos;
+    }
+  }
+  return obj;
+}
+
+static bool format_fields_to(std::string &out, std::string_view fmt,
+                             const std::vector<std::shared_ptr<object>> &args,
+                             const std::shared_ptr<dict> &kwargs,
+                             field_numbering &numbering) {
+  size_t i = 0;
+
+  while (i < fmt.size()) {
+    auto special = fmt.find_first_of("{}", i);
+    out += fmt.substr(i, special - i);
+    if (special == std::string_view::npos) {
+      break;
+    }
+
+    i = special + 1;
+    if (fmt[special] == '}') {
+      if (i == fmt.size() || fmt[i] != '}') {
+        raise_error(exception_klass::value_error,
+                    "Single '}' encountered in format string");
+        return false;
+      }
+      out += '}';
+      i++;
+      continue;
+    }
+    if (i == fmt.size()) {
+      raise_error(exception_klass::value_error,
+                  "Single '{' encountered in format string");
+      return false;
+    }
+    if (fmt[i] == '{') {
+      out += '{';
+      i++;
+      continue;
+    }
+
+    // find the closing brace, the spec may nest one level of fields
+    size_t depth = 1;
+    size_t close = i;
+    for (; close < fmt.size() && depth > 0; close++) {
+      depth += fmt[close] == '{';
+      depth -= fmt[close] == '}';
+    }
+    if (depth != 0) {
+      raise_error(exception_klass::value_error,
+                  "expected '}' before end of string");
+      return false;
+    }
+    auto field = fmt.substr(i, close - 1 - i);
+    i = close;
+
+    auto colon = field.find(':');
+    auto head = field.substr(0, colon);
+    auto spec = colon == std::string_view::npos ? std::string_view{}
+                                                : field.substr(colon + 1);
+
+    char conversion = '\0';
+    if (auto bang = head.find('!'); bang != std::string_view::npos) {
+      if (bang + 2 != head.size()) {
+        raise_error(exception_klass::value_error,
+                    bang + 1 == head.size()
+                        ? "end of string while looking for conversion "
+                          "specifier"
+                        : "expected ':' after conversion specifier");
+        return false;
+      }
+      conversion = head[bang + 1];
+      if (conversion != 's' && conversion != 'r' && conversion != 'a') {
+        raise_error(exception_klass::value_error,
+                    std::format("Unknown conversion specifier {}",
+                                conversion));
+        return false;
+      }
+      head = head.substr(0, bang);
+    }
+
+    auto value = resolve_field(head, args, kwargs, numbering);
+    if (value == nullptr) {
+      return false;
+    }
+
+    if (spec.find('{') == std::string_view::npos) {
+      if (!format_value_to(out, value, conversion, spec)) {
+        return false;
+      }
+    } else {
+      std::string nested;
+      if (!format_fields_to(nested, spec, args, kwargs, numbering) ||
+          !format_value_to(out, value, conversion, nested)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool cppython::format_string_to(
+    std::string &out, std::string_view fmt,
+    const std::vector<std::shared_ptr<object>> &args,
+    const std::shared_ptr<dict> &kwargs) {
+  field_numbering numbering;
+  return format_fields_to(out, fmt, args, kwargs, numbering);
+}
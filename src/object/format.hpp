@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+class object;
+class dict;
+
+/// @brief a parsed python format spec:
+/// [[fill]align][sign][#][0][width][,|_][.precision][type]
+struct format_spec {
+  char fill{' '};
+  char align{'\0'}; // '<', '>', '^', '=' or '\0' for the type's default
+  char sign{'-'};
+  bool alternate{false};
+  size_t width{0};
+  char grouping{'\0'};
+  int precision{-1};
+  char type{'\0'};
+
+  /// @brief nullopt with ValueError pending when spec doesn't parse
+  static std::optional<format_spec> parse(std::string_view spec);
+};
+
+/// @brief appends format(v, spec) to out. ints, floats and strings are
+/// formatted straight into out, other objects go through str(). false
+/// when spec is invalid for v, with ValueError pending.
+bool format_value_to(std::string &out, const std::shared_ptr<object> &v,
+                     std::string_view spec);
+
+/// @brief appends v converted by a !s, !r or !a flag, then formatted by spec
+bool format_value_to(std::string &out, const std::shared_ptr<object> &v,
+                     char conversion, std::string_view spec);
+
+/// @brief appends fmt.format(*args, **kwargs) to out in one pass, kwargs
+/// may be nullptr. false when fmt is malformed or a field could not be
+/// looked up or formatted, with the exception pending.
+bool format_string_to(std::string &out, std::string_view fmt,
+                      const std::vector<std::shared_ptr<object>> &args,
+                      const std::shared_ptr<dict> &kwargs);
+
+} // namespace cppython
@@ -120,6 +120,26 @@ std::shared_ptr<object> integer_klass::mod(std::shared_ptr<object> x,
   return binary_op(x, y, std::modulus<int>{});
 }
 
+std::shared_ptr<object> integer_klass::bit_and(std::shared_ptr<object> x,
+                                               std::shared_ptr<object> y) {
+  return binary_op(x, y, std::bit_and<int>{});
+}
+
+std::shared_ptr<object> integer_klass::bit_or(std::shared_ptr<object> x,
+                                              std::shared_ptr<object> y) {
+  return binary_op(x, y, std::bit_or<int>{});
+}
+
+std::shared_ptr<object> integer_klass::bit_xor(std::shared_ptr<object> x,
+                                               std::shared_ptr<object> y) {
+  return binary_op(x, y, std::bit_xor<int>{});
+}
+
+size_t integer_klass::hash(std::shared_ptr<object> x) {
+  assert(x && (x->get_klass() == this));
+  return std::hash<int>{}(std::static_pointer_cast<integer>(x)->get_value());
+}
+
 std::shared_ptr<object> integer_klass::allocate_instance(
     std::shared_ptr<object> obj_type,
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
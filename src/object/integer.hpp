@@ -55,6 +55,15 @@ public:
   std::shared_ptr<object> mod(std::shared_ptr<object> x,
                               std::shared_ptr<object> y) override;
 
+  std::shared_ptr<object> bit_and(std::shared_ptr<object> x,
+                                  std::shared_ptr<object> y) override;
+  std::shared_ptr<object> bit_or(std::shared_ptr<object> x,
+                                 std::shared_ptr<object> y) override;
+  std::shared_ptr<object> bit_xor(std::shared_ptr<object> x,
+                                  std::shared_ptr<object> y) override;
+
+  size_t hash(std::shared_ptr<object> x) override;
+
   std::shared_ptr<object> allocate_instance(
       std::shared_ptr<object> obj_type,
       std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
@@ -0,0 +1,183 @@
+#include "object/iterator.hpp"
+#include "object/dict.hpp"
+#include "object/integer.hpp"
+#include "object/string.hpp"
+#include "object/tuple.hpp"
+#include "runtime/interpreter.hpp"
+#include "runtime/static_value.hpp"
+
+#include <cassert>
+
+using namespace cppython;
+
+void map_iterator_klass::initialize() {
+  set_dict(std::make_shared<dict>());
+  set_name("map");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<object> map_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto map_obj = std::static_pointer_cast<map_iterator>(x);
+
+  auto args = std::make_shared<std::vector<std::shared_ptr<object>>>();
+  args->reserve(map_obj->get_iters().size());
+  for (const auto &it : map_obj->get_iters()) {
+    auto v = it->next();
+    if (v == nullptr) {
+      return nullptr;
+    }
+    args->push_back(v);
+  }
+  return interpreter::get_instance()->call_virtual(map_obj->get_func(), args);
+}
+
+std::shared_ptr<object> map_iterator_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  assert(args && args->size() >= 2);
+
+  std::vector<std::shared_ptr<object>> iters;
+  iters.reserve(args->size() - 1);
+  for (auto i = args->begin() + 1; i != args->end(); ++i) {
+    iters.push_back((*i)->iter());
+  }
+  return std::make_shared<map_iterator>(args->at(0), std::move(iters));
+}
+
+map_iterator::map_iterator(std::shared_ptr<object> func,
+                           std::vector<std::shared_ptr<object>> iters)
+    : func{func}, iters{std::move(iters)} {
+  set_klass(map_iterator_klass::get_instance());
+}
+
+void filter_iterator_klass::initialize() {
+  set_dict(std::make_shared<dict>());
+  set_name("filter");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<object> filter_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto filter_obj = std::static_pointer_cast<filter_iterator>(x);
+  auto func = filter_obj->get_func();
+
+  std::shared_ptr<object> v;
+  while ((v = filter_obj->get_iter()->next()) != nullptr) {
+    if (func == static_value::none_value) {
+      if (static_value::is_true(v)) {
+        return v;
+      }
+      continue;
+    }
+
+    auto args = std::make_shared<std::vector<std::shared_ptr<object>>>();
+    args->push_back(v);
+    if (static_value::is_true(
+            interpreter::get_instance()->call_virtual(func, args))) {
+      return v;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<object> filter_iterator_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  assert(args && args->size() == 2);
+  return std::make_shared<filter_iterator>(args->at(0), args->at(1)->iter());
+}
+
+filter_iterator::filter_iterator(std::shared_ptr<object> func,
+                                 std::shared_ptr<object> iter)
+    : func{func}, iter{iter} {
+  set_klass(filter_iterator_klass::get_instance());
+}
+
+void enumerate_iterator_klass::initialize() {
+  set_dict(std::make_shared<dict>());
+  set_name("enumerate");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<object>
+enumerate_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto enum_obj = std::static_pointer_cast<enumerate_iterator>(x);
+
+  auto v = enum_obj->get_iter()->next();
+  if (v == nullptr) {
+    return nullptr;
+  }
+
+  auto result =
+      tuple::create({std::make_shared<integer>(enum_obj->get_iter_cnt()), v});
+  enum_obj->inc_cnt();
+  return result;
+}
+
+std::shared_ptr<object> enumerate_iterator_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  assert(args && args->size() >= 1 && args->size() <= 2);
+
+  int start = 0;
+  if (args->size() == 2) {
+    assert(args->at(1)->get_klass() == integer_klass::get_instance());
+    start = std::static_pointer_cast<integer>(args->at(1))->get_value();
+  }
+  return std::make_shared<enumerate_iterator>(args->at(0)->iter(), start);
+}
+
+enumerate_iterator::enumerate_iterator(std::shared_ptr<object> iter, int start)
+    : iter{iter}, iter_cnt{start} {
+  set_klass(enumerate_iterator_klass::get_instance());
+}
+
+void zip_iterator_klass::initialize() {
+  set_dict(std::make_shared<dict>());
+  set_name("zip");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<object> zip_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto zip_obj = std::static_pointer_cast<zip_iterator>(x);
+
+  if (zip_obj->get_iters().empty()) {
+    return nullptr;
+  }
+
+  auto &&iters = zip_obj->get_iters();
+  auto result = tuple::create(iters.size());
+  for (size_t i{0}; i < iters.size(); ++i) {
+    auto v = iters[i]->next();
+    if (v == nullptr) {
+      return nullptr;
+    }
+    result->set(i, v);
+  }
+  return result;
+}
+
+std::shared_ptr<object> zip_iterator_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  std::vector<std::shared_ptr<object>> iters;
+  if (args) {
+    iters.reserve(args->size());
+    for (const auto &e : *args) {
+      iters.push_back(e->iter());
+    }
+  }
+  return std::make_shared<zip_iterator>(std::move(iters));
+}
+
+zip_iterator::zip_iterator(std::vector<std::shared_ptr<object>> iters)
+    : iters{std::move(iters)} {
+  set_klass(zip_iterator_klass::get_instance());
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace cppython {
+
+// map, filter, enumerate and zip are lazy: each object is its own iterator
+// and pulls exactly one item from the underlying iterators per next().
+
+class map_iterator_klass : public klass, public singleton<map_iterator_klass> {
+  friend class singleton<map_iterator_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+
+  /// @brief map(func, iterable, ...)
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+class map_iterator : public object {
+public:
+  map_iterator(std::shared_ptr<object> func,
+               std::vector<std::shared_ptr<object>> iters);
+
+  auto get_func() { return func; }
+  auto &get_iters() { return iters; }
+
+private:
+  std::shared_ptr<object> func;
+  std::vector<std::shared_ptr<object>> iters;
+};
+
+class filter_iterator_klass : public klass,
+                              public singleton<filter_iterator_klass> {
+  friend class singleton<filter_iterator_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+
+  /// @brief filter(func or None, iterable)
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+class filter_iterator : public object {
+public:
+  filter_iterator(std::shared_ptr<object> func, std::shared_ptr<object> iter);
+
+  auto get_func() { return func; }
+  auto get_iter() { return iter; }
+
+private:
+  std::shared_ptr<object> func;
+  std::shared_ptr<object> iter;
+};
+
+class enumerate_iterator_klass : public klass,
+                                 public singleton<enumerate_iterator_klass> {
+  friend class singleton<enumerate_iterator_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+
+  /// @brief enumerate(iterable, start=0)
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+class enumerate_iterator : public object {
+public:
+  enumerate_iterator(std::shared_ptr<object> iter, int start);
+
+  auto get_iter() { return iter; }
+  int get_iter_cnt() { return iter_cnt; }
+  void inc_cnt() { iter_cnt++; }
+
+private:
+  std::shared_ptr<object> iter;
+  int iter_cnt;
+};
+
+class zip_iterator_klass : public klass, public singleton<zip_iterator_klass> {
+  friend class singleton<zip_iterator_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+
+  /// @brief zip(iterable, ...)
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+class zip_iterator : public object {
+public:
+  zip_iterator(std::vector<std::shared_ptr<object>> iters);
+
+  auto &get_iters() { return iters; }
+
+private:
+  std::vector<std::shared_ptr<object>> iters;
+};
+
+} // namespace cppython
@@ -1,7 +1,9 @@
 #include "object/klass.hpp"
 #include "object/dict.hpp"
+#include "object/exception.hpp"
 #include "object/integer.hpp"
 #include "object/list.hpp"
+#include "object/tuple.hpp"
 #include "runtime/function.hpp"
 #include "runtime/interpreter.hpp"
 #include "runtime/static_value.hpp"
@@ -89,13 +91,18 @@ std::weak_ordering klass::compare(klass *x, klass *y) {
   return x->get_name() <=> y->get_name();
 }
 
+/// @brief the text returned by __str__ or __repr__. Empty when the method
+/// raised, the exception is left pending.
+static std::shared_ptr<string> text_of(const std::shared_ptr<object> &r) {
+  return r ? r->str() : std::make_shared<string>("");
+}
+
 std::shared_ptr<string> klass::str(std::shared_ptr<object> obj) {
 
   auto str_method = get_klass_attr(obj, string_table::get_instance()->str_str);
   if (str_method != static_value::none_value) {
-    return interpreter::get_instance()
-        ->call_virtual(str_method, nullptr)
-        ->str();
+    return text_of(
+        interpreter::get_instance()->call_virtual(str_method, nullptr));
   }
 
   return repr(obj);
@@ -106,9 +113,8 @@ std::shared_ptr<string> klass::repr(std::shared_ptr<object> obj) {
   auto repr_method =
       get_klass_attr(obj, string_table::get_instance()->repr_str);
   if (repr_method != static_value::none_value) {
-    return interpreter::get_instance()
-        ->call_virtual(repr_method, nullptr)
-        ->str();
+    return text_of(
+        interpreter::get_instance()->call_virtual(repr_method, nullptr));
   }
 
   return std::make_shared<string>(
@@ -200,12 +206,46 @@ std::shared_ptr<object> klass::get_klass_attr(std::shared_ptr<object> x,
   return result;
 }
 
+size_t klass::hash(std::shared_ptr<object> x) {
+  auto hash_method = get_klass_attr(x, string_table::get_instance()->hash_str);
+  if (hash_method != static_value::none_value) {
+    auto r = interpreter::get_instance()->call_virtual(hash_method, nullptr);
+    if (r == nullptr) {
+      // __hash__ raised, the exception is pending
+      return 0;
+    }
+    assert(r->get_klass() == integer_klass::get_instance());
+    return std::hash<int>{}(std::static_pointer_cast<integer>(r)->get_value());
+  }
+
+  // objects are compared by identity unless the class says otherwise
+  return std::hash<object *>{}(x.get());
+}
+
+size_t klass::unhashable(const std::shared_ptr<object> &x) {
+  raise_error(exception_klass::type_error,
+              std::format("unhashable type: '{}'", x->get_klass()->get_name()));
+  return 0;
+}
+
 std::shared_ptr<object> klass::iter(std::shared_ptr<object> x) {
-  return find_and_call(x, nullptr, string_table::get_instance()->iter_str);
+  auto r = find_and_call(x, nullptr, string_table::get_instance()->iter_str);
+  if (r == nullptr) {
+    // native callers walk an exhausted iterator, then the pending exception
+    // is unwound
+    return tuple::create(size_t{0})->iter();
+  }
+  return r;
 }
 
 std::shared_ptr<object> klass::next(std::shared_ptr<object> x) {
-  return find_and_call(x, nullptr, string_table::get_instance()->next_str);
+  auto r = find_and_call(x, nullptr, string_table::get_instance()->next_str);
+  // the StopIteration raised by __next__ becomes the end of iteration
+  // sentinel native callers expect
+  if (r == nullptr) {
+    interpreter::get_instance()->clear_stop_iteration();
+  }
+  return r;
 }
 
 std::shared_ptr<object> klass::len(std::shared_ptr<object> x) {
@@ -225,6 +265,9 @@ std::shared_ptr<object> klass::allocate_instance(
     inst = std::make_shared<list>();
   } else if (mro->has_pointer(dict_klass::get_instance()->get_type_object())) {
     inst = std::make_shared<dict>();
+  } else if (mro->has_pointer(
+                 exception_klass::base_exception->get_type_object())) {
+    inst = std::make_shared<exception_object>(this);
   } else {
     inst = std::make_shared<object>();
   }
@@ -251,10 +294,10 @@ klass::find_and_call(std::shared_ptr<object> x,
     return interpreter::get_instance()->call_virtual(func, args);
   }
 
-  std::println("class {} Error : unsupport operation for class",
-               x->get_klass()->get_name());
-  assert(false);
-  return static_value::none_value;
+  return raise_error(exception_klass::type_error,
+                     std::format("'{}' object does not support '{}'",
+                                 x->get_klass()->get_name(),
+                                 func_name->get_value()));
 }
 
 std::shared_ptr<object> klass::find_in_parents(std::shared_ptr<object> x,
@@ -85,6 +85,18 @@ public:
                                       std::shared_ptr<object> y) {
     return nullptr;
   }
+  virtual std::shared_ptr<object> bit_and(std::shared_ptr<object> x,
+                                          std::shared_ptr<object> y) {
+    return nullptr;
+  }
+  virtual std::shared_ptr<object> bit_or(std::shared_ptr<object> x,
+                                         std::shared_ptr<object> y) {
+    return nullptr;
+  }
+  virtual std::shared_ptr<object> bit_xor(std::shared_ptr<object> x,
+                                          std::shared_ptr<object> y) {
+    return nullptr;
+  }
   virtual std::shared_ptr<object> subscr(std::shared_ptr<object> x,
                                          std::shared_ptr<object> y);
   virtual void store_subscr(std::shared_ptr<object> x,
@@ -108,6 +120,10 @@ public:
                                            std::shared_ptr<object> y) {
     return nullptr;
   }
+  /// @brief an unhashable type raises TypeError and returns 0, so the caller
+  /// checks for a pending exception
+  virtual size_t hash(std::shared_ptr<object> x);
+
   virtual std::shared_ptr<object> iter(std::shared_ptr<object> x);
   virtual std::shared_ptr<object> next(std::shared_ptr<object> x);
   virtual std::shared_ptr<object> len(std::shared_ptr<object> x);
@@ -119,13 +135,19 @@ public:
   allocate_instance(std::shared_ptr<object> obj_type,
                     std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
 
+  /// @brief attribute y of the class of x or of its bases, not bound to x
+  std::shared_ptr<object> find_in_parents(std::shared_ptr<object> x,
+                                          std::shared_ptr<object> y);
+
+protected:
+  /// @brief hash of a type whose instances can't be hashed
+  size_t unhashable(const std::shared_ptr<object> &x);
+
 private:
   std::shared_ptr<object>
   find_and_call(std::shared_ptr<object> x,
                 std::shared_ptr<std::vector<std::shared_ptr<object>>> args,
                 std::shared_ptr<string> func_name);
-  std::shared_ptr<object> find_in_parents(std::shared_ptr<object> x,
-                                          std::shared_ptr<object> y);
 
 private:
   std::shared_ptr<list> super;
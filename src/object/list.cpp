@@ -1,14 +1,21 @@
 #include "object/list.hpp"
 #include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/float.hpp"
 #include "object/integer.hpp"
+#include "object/slice.hpp"
 #include "object/string.hpp"
+#include "object/tuple.hpp"
 #include "runtime/function.hpp"
 #include "runtime/interpreter.hpp"
 #include "runtime/string_table.hpp"
+#include "utils/timsort.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <format>
 #include <ranges>
+#include <string_view>
 #include <unordered_map>
 
 using namespace cppython;
@@ -105,11 +112,13 @@ std::shared_ptr<object> list_klass::add(std::shared_ptr<object> x,
   auto &&lst_x = list_obj_x->get_value();
   auto &&lst_y = list_obj_y->get_value();
 
-  const auto lst_x_y = {lst_x, lst_y};
-
-  auto result = lst_x_y | std::views::join;
-
-  return std::make_shared<list>(std::from_range, result);
+  auto result = std::make_shared<list>();
+  result->reserve(lst_x.size() + lst_y.size());
+  result->get_value().insert(result->get_value().end(), lst_x.begin(),
+                             lst_x.end());
+  result->get_value().insert(result->get_value().end(), lst_y.begin(),
+                             lst_y.end());
+  return result;
 }
 
 std::shared_ptr<object> list_klass::mul(std::shared_ptr<object> x,
@@ -121,46 +130,158 @@ std::shared_ptr<object> list_klass::mul(std::shared_ptr<object> x,
   auto int_obj_y = std::static_pointer_cast<integer>(y);
 
   auto &&lst = list_obj_x->get_value();
-  auto &&n = int_obj_y->get_value();
-
-  auto lst_n = std::views::repeat(lst, n) | std::views::join;
+  auto n = std::max(int_obj_y->get_value(), 0);
 
-  return std::make_shared<list>(std::from_range, lst_n);
+  auto result = std::make_shared<list>();
+  result->reserve(lst.size() * n);
+  for (int i{0}; i < n; ++i) {
+    result->get_value().insert(result->get_value().end(), lst.begin(),
+                               lst.end());
+  }
+  return result;
 }
 
 std::shared_ptr<object> list_klass::subscr(std::shared_ptr<object> x,
                                            std::shared_ptr<object> y) {
   assert(x->get_klass() == this);
-  assert(y->get_klass() == integer_klass::get_instance());
-
   auto list_obj = std::static_pointer_cast<list>(x);
-  auto index_obj = std::static_pointer_cast<integer>(y);
 
-  return list_obj->at(index_obj->get_value());
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto &&lst = list_obj->get_value();
+    auto bounds = std::static_pointer_cast<slice>(y)->indices(lst.size());
+    if (!bounds) {
+      return nullptr;
+    }
+    auto &b = *bounds;
+    if (b.step == 1) {
+      // one range construct, the items are copied as a block
+      auto first = lst.begin() + b.start;
+      return std::make_shared<list>(first, first + b.length);
+    }
+
+    auto result = std::make_shared<list>();
+    result->get_value().reserve(b.length);
+    for (size_t i{0}; i < b.length; ++i) {
+      result->append(lst[b.start + i * b.step]);
+    }
+    return result;
+  }
+
+  auto index = sequence_index("list", y, list_obj->size());
+  if (!index) {
+    return nullptr;
+  }
+  return list_obj->get_value()[*index];
+}
+
+/// @brief the items of the right hand side of a slice assignment, taken
+/// before the list changes so a[:] = a works
+static std::vector<std::shared_ptr<object>>
+items_of(const std::shared_ptr<object> &x) {
+  if (x->get_klass() == list_klass::get_instance()) {
+    return std::static_pointer_cast<list>(x)->get_value();
+  }
+  if (x->get_klass() == tuple_klass::get_instance()) {
+    auto items = std::static_pointer_cast<tuple>(x)->get_value();
+    return {items.begin(), items.end()};
+  }
+
+  std::vector<std::shared_ptr<object>> items;
+  auto iter = x->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    items.push_back(v);
+  }
+  return items;
 }
 
 void list_klass::store_subscr(std::shared_ptr<object> x,
                               std::shared_ptr<object> y,
                               std::shared_ptr<object> z) {
   assert(x->get_klass() == this);
-  assert(y->get_klass() == integer_klass::get_instance());
-
   auto list_obj = std::static_pointer_cast<list>(x);
-  auto index_obj = std::static_pointer_cast<integer>(y);
 
-  list_obj->at(index_obj->get_value()) = z;
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto &&lst = list_obj->get_value();
+    auto bounds = std::static_pointer_cast<slice>(y)->indices(lst.size());
+    if (!bounds) {
+      return;
+    }
+    auto &b = *bounds;
+    auto items = items_of(z);
+
+    if (b.step == 1) {
+      auto first = lst.begin() + b.start;
+      auto common = std::min(items.size(), b.length);
+      std::ranges::move(items.begin(), items.begin() + common, first);
+      if (items.size() < b.length) {
+        lst.erase(first + common, first + b.length);
+      } else {
+        lst.insert(first + common,
+                   std::make_move_iterator(items.begin() + common),
+                   std::make_move_iterator(items.end()));
+      }
+      return;
+    }
+
+    if (items.size() != b.length) {
+      raise_error(exception_klass::value_error,
+                  std::format("attempt to assign sequence of size {} to "
+                              "extended slice of size {}",
+                              items.size(), b.length));
+      return;
+    }
+    for (size_t i{0}; i < b.length; ++i) {
+      lst[b.start + i * b.step] = std::move(items[i]);
+    }
+    return;
+  }
+
+  if (auto index =
+          sequence_index("list", y, list_obj->size(), "assignment index")) {
+    list_obj->get_value()[*index] = z;
+  }
 }
 
 void list_klass::del_subscr(std::shared_ptr<object> x,
                             std::shared_ptr<object> y) {
   assert(x->get_klass() == this);
-  assert(y->get_klass() == integer_klass::get_instance());
-
   auto list_obj = std::static_pointer_cast<list>(x);
-  auto index_obj = std::static_pointer_cast<integer>(y);
 
-  list_obj->get_value().erase(list_obj->get_value().begin() +
-                              index_obj->get_value());
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto &&lst = list_obj->get_value();
+    auto bounds = std::static_pointer_cast<slice>(y)->indices(lst.size());
+    if (!bounds) {
+      return;
+    }
+    auto &b = *bounds;
+    if (b.length == 0) {
+      return;
+    }
+    // walk a backwards slice forwards, it selects the same items
+    size_t first = b.step > 0 ? b.start : b.start + (b.length - 1) * b.step;
+    size_t step = b.step > 0 ? b.step : -b.step;
+    if (step == 1) {
+      lst.erase(lst.begin() + first, lst.begin() + first + b.length);
+      return;
+    }
+
+    // compact the survivors over the deleted items in one pass
+    size_t out = first;
+    for (size_t i = first; i < lst.size(); ++i) {
+      if (i < first + b.length * step && (i - first) % step == 0) {
+        continue;
+      }
+      lst[out++] = std::move(lst[i]);
+    }
+    lst.resize(out);
+    return;
+  }
+
+  if (auto index = sequence_index("list", y, list_obj->size(),
+                                  "assignment index")) {
+    list_obj->get_value().erase(list_obj->get_value().begin() + *index);
+  }
 }
 
 std::shared_ptr<object> list_klass::contains(std::shared_ptr<object> x,
@@ -175,6 +296,10 @@ std::shared_ptr<object> list_klass::contains(std::shared_ptr<object> x,
       }));
 }
 
+size_t list_klass::hash(std::shared_ptr<object> x) {
+  return unhashable(x);
+}
+
 std::shared_ptr<object> list_klass::iter(std::shared_ptr<object> x) {
   assert(x && x->get_klass() == this);
   auto list_obj = std::static_pointer_cast<list>(x);
@@ -190,23 +315,26 @@ std::shared_ptr<object> list_klass::len(std::shared_ptr<object> x) {
 std::shared_ptr<object> list_klass::allocate_instance(
     std::shared_ptr<object> obj_type,
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto result = std::make_shared<list>();
   if (!args || args->size() == 0) {
-    return std::make_shared<list>();
-  } else {
-    return nullptr;
+    return result;
+  }
+
+  // list(iterable)
+  auto iter = args->at(0)->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    result->append(v);
   }
+  return result;
 }
 
-std::shared_ptr<object>
-list::list_append(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto arg_0 = args->at(0);
+std::shared_ptr<object> list::list_append(vector_args_t args) {
+  assert(args.size() == 2);
+  auto &arg_0 = args[0];
   assert(arg_0->isinstance(list_klass::get_instance()->get_type_object()));
 
-  auto list_obj = std::static_pointer_cast<list>(arg_0);
-
-  auto arg_1 = args->at(1);
-
-  list_obj->append(arg_1);
+  std::static_pointer_cast<list>(arg_0)->append(args[1]);
   return static_value::none_value;
 }
 
@@ -277,6 +405,27 @@ list::list_reverse(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
   return static_value::none_value;
 }
 
+/// @brief decorate each value with the raw form of its key, sort the pairs by
+/// key and write the values back
+template <typename Key, typename Projection, typename Compare>
+static void sort_decorated(std::vector<std::shared_ptr<object>> &values,
+                           const std::vector<std::shared_ptr<object>> &keys,
+                           Projection proj, Compare comp) {
+  std::vector<std::pair<Key, std::shared_ptr<object>>> items;
+  items.reserve(values.size());
+  for (size_t i{0}; i < values.size(); ++i) {
+    items.emplace_back(proj(keys[i]), std::move(values[i]));
+  }
+
+  tim_sort(items.begin(), items.end(), [&comp](const auto &l, const auto &r) {
+    return comp(l.first, r.first);
+  });
+
+  for (size_t i{0}; i < values.size(); ++i) {
+    values[i] = std::move(items[i].second);
+  }
+}
+
 std::shared_ptr<object>
 list::list_sort(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
 
@@ -284,12 +433,95 @@ list::list_sort(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
   assert(arg_0->isinstance(list_klass::get_instance()->get_type_object()));
   auto list_obj = std::static_pointer_cast<list>(arg_0);
 
+  // sort(*, key=None, reverse=False)
+  std::shared_ptr<object> key_func = static_value::none_value;
+  bool reverse = false;
+  if (auto kw_dict = dict::pop_keyword_args(*args); kw_dict) {
+    key_func = kw_dict->at(std::make_shared<string>("key"));
+    reverse = static_value::is_true(
+        kw_dict->at(std::make_shared<string>("reverse")));
+  }
+
   auto &&lst = list_obj->get_value();
 
-  std::ranges::sort(lst, [](const std::shared_ptr<object> &l,
-                            const std::shared_ptr<object> &r) {
-    return l->less(r) == static_value::true_value;
-  });
+  // reverse before and after a stable sort, so equal elements keep their
+  // original order
+  if (reverse) {
+    std::ranges::reverse(lst);
+  }
+
+  auto interp = interpreter::get_instance();
+  std::vector<std::shared_ptr<object>> keys;
+  if (key_func == static_value::none_value) {
+    keys = lst;
+  } else {
+    keys.reserve(lst.size());
+    for (const auto &e : lst) {
+      auto key_args = std::make_shared<std::vector<std::shared_ptr<object>>>();
+      key_args->push_back(e);
+      auto key = interp->call_virtual(key_func, key_args);
+      if (key == nullptr) {
+        // the key function raised, the list is left as it was
+        if (reverse) {
+          std::ranges::reverse(lst);
+        }
+        return nullptr;
+      }
+      keys.push_back(std::move(key));
+    }
+  }
+
+  // when all keys share one builtin klass, compare the raw values directly
+  // instead of dispatching less() on every comparison
+  auto all_of_klass = [&keys](klass *k) {
+    return std::ranges::all_of(keys, [k](const std::shared_ptr<object> &e) {
+      return e->get_klass() == k;
+    });
+  };
+
+  if (all_of_klass(integer_klass::get_instance())) {
+    sort_decorated<int>(
+        lst, keys,
+        [](const std::shared_ptr<object> &e) {
+          return static_cast<integer *>(e.get())->get_value();
+        },
+        std::less<int>{});
+  } else if (all_of_klass(float_klass::get_instance())) {
+    sort_decorated<double>(
+        lst, keys,
+        [](const std::shared_ptr<object> &e) {
+          return static_cast<float_num *>(e.get())->get_value();
+        },
+        std::less<double>{});
+  } else if (all_of_klass(string_klass::get_instance())) {
+    sort_decorated<std::string_view>(
+        lst, keys,
+        [](const std::shared_ptr<object> &e) {
+          return std::string_view{static_cast<string *>(e.get())->get_value()};
+        },
+        std::less<std::string_view>{});
+  } else {
+    // a comparison may raise, then the rest are skipped and the list is put
+    // back as it was
+    auto saved = lst;
+    sort_decorated<std::shared_ptr<object>>(
+        lst, keys, std::identity{},
+        [interp](const std::shared_ptr<object> &l,
+                 const std::shared_ptr<object> &r) {
+          return !interp->has_pending_exception() && value_less{}(l, r);
+        });
+    if (interp->has_pending_exception()) {
+      lst = std::move(saved);
+      if (reverse) {
+        std::ranges::reverse(lst);
+      }
+      return nullptr;
+    }
+  }
+
+  if (reverse) {
+    std::ranges::reverse(lst);
+  }
 
   return static_value::none_value;
 }
@@ -301,17 +533,28 @@ list::list_extend(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
   assert(arg_0->isinstance(list_klass::get_instance()->get_type_object()));
   auto list_obj = std::static_pointer_cast<list>(arg_0);
 
-  auto obj = args->at(1);
+  list_obj->extend(args->at(1));
+  return static_value::none_value;
+}
 
-  auto next_func = obj->iter()->getattr(string_table::get_instance()->next_str);
-  assert(next_func != static_value::none_value);
+void list::extend(const std::shared_ptr<object> &iterable) {
+  if (iterable->get_klass() == list_klass::get_instance()) {
+    // copy first, lst.extend(lst) must not read what it appends
+    auto items = std::static_pointer_cast<list>(iterable)->get_value();
+    value.insert(value.end(), items.begin(), items.end());
+    return;
+  }
+  if (iterable->get_klass() == tuple_klass::get_instance()) {
+    auto items = std::static_pointer_cast<tuple>(iterable)->get_value();
+    value.insert(value.end(), items.begin(), items.end());
+    return;
+  }
 
+  auto iter = iterable->iter();
   std::shared_ptr<object> v;
-  while ((v = interpreter::get_instance()->call_virtual(next_func, nullptr)) !=
-         nullptr) {
-    list_obj->append(v);
+  while ((v = iter->next()) != nullptr) {
+    value.push_back(v);
   }
-  return static_value::none_value;
 }
 
 std::shared_ptr<object>
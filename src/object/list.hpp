@@ -2,6 +2,7 @@
 
 #include "object/klass.hpp"
 #include "object/object.hpp"
+#include "runtime/function.hpp"
 #include "runtime/static_value.hpp"
 #include "utils/singleton.hpp"
 
@@ -39,6 +40,8 @@ public:
   std::shared_ptr<object> contains(std::shared_ptr<object> x,
                                    std::shared_ptr<object> y) override;
 
+  size_t hash(std::shared_ptr<object> x) override;
+
   std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
   std::shared_ptr<object> len(std::shared_ptr<object> x) override;
 
@@ -60,6 +63,7 @@ public:
   auto rbegin() { return value.rbegin(); }
 
   size_t size() { return value.size(); }
+  void reserve(size_t cnt) { value.reserve(cnt); }
   void resize(size_t cnt) { value.resize(cnt); }
   void resize(size_t cnt, const std::shared_ptr<object> &x) {
     value.resize(cnt, x);
@@ -89,6 +93,8 @@ public:
 
   [[nodiscard]] bool empty() { return value.empty(); }
   void append(const std::shared_ptr<object> &x) { value.push_back(x); }
+  /// @brief appends the items of iterable, a list or tuple as one block
+  void extend(const std::shared_ptr<object> &iterable);
   void set_at(size_t pos, const std::shared_ptr<object> &x) {
     if (pos < value.size()) {
       value.at(pos) = x;
@@ -112,8 +118,7 @@ public:
 
   decltype(auto) top() { return value.back(); }
 
-  static std::shared_ptr<object>
-  list_append(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object> list_append(vector_args_t args);
 
   static std::shared_ptr<object>
   list_index(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
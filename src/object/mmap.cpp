@@ -0,0 +1,426 @@
+#include "object/mmap.hpp"
+#include "object/bytearray.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/integer.hpp"
+#include "object/slice.hpp"
+#include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/static_value.hpp"
+#include "utils/string_kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace cppython {
+
+/// @brief one mapped view of a file, unmapped with its last mmap_file
+class file_mapping {
+public:
+  file_mapping(const char *data, size_t size) : data{data}, size{size} {}
+  file_mapping(const file_mapping &) = delete;
+  file_mapping &operator=(const file_mapping &) = delete;
+  ~file_mapping();
+
+  static std::shared_ptr<file_mapping> map(int fd, size_t length);
+
+  const char *data;
+  size_t size;
+};
+
+} // namespace cppython
+
+using namespace cppython;
+
+static void raise_map_error(int error) {
+  raise_error(exception_klass::os_error,
+              std::format("[Errno {}] {}", error, std::strerror(error)));
+}
+
+static void raise_length_error() {
+  raise_error(exception_klass::value_error,
+              "mmap length is greater than file size");
+}
+
+#ifdef _WIN32
+std::shared_ptr<file_mapping> file_mapping::map(int fd, size_t length) {
+  auto handle = reinterpret_cast<HANDLE>(::_get_osfhandle(fd));
+  LARGE_INTEGER file_size;
+  if (handle == INVALID_HANDLE_VALUE || !::GetFileSizeEx(handle, &file_size)) {
+    raise_map_error(EBADF);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_size.QuadPart);
+  if (length == 0) {
+    length = size;
+  }
+  if (length > size) {
+    raise_length_error();
+    return nullptr;
+  }
+  if (length == 0) {
+    // an empty file can't be mapped, but it can be looked at
+    return std::make_shared<file_mapping>(nullptr, 0);
+  }
+
+  auto section =
+      ::CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (section == nullptr) {
+    raise_error(exception_klass::os_error,
+                std::format("[WinError {}] cannot map the file",
+                            ::GetLastError()));
+    return nullptr;
+  }
+  auto view = ::MapViewOfFile(section, FILE_MAP_READ, 0, 0, length);
+  // the view keeps the section alive
+  ::CloseHandle(section);
+  if (view == nullptr) {
+    raise_error(exception_klass::os_error,
+                std::format("[WinError {}] cannot map the file",
+                            ::GetLastError()));
+    return nullptr;
+  }
+  return std::make_shared<file_mapping>(static_cast<const char *>(view),
+                                        length);
+}
+
+file_mapping::~file_mapping() {
+  if (data != nullptr) {
+    ::UnmapViewOfFile(data);
+  }
+}
+#else
+std::shared_ptr<file_mapping> file_mapping::map(int fd, size_t length) {
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    raise_map_error(errno);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(st.st_size);
+  if (length == 0) {
+    length = size;
+  }
+  if (length > size) {
+    raise_length_error();
+    return nullptr;
+  }
+  if (length == 0) {
+    // an empty file can't be mapped, but it can be looked at
+    return std::make_shared<file_mapping>(nullptr, 0);
+  }
+
+  auto view = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  if (view == MAP_FAILED) {
+    raise_map_error(errno);
+    return nullptr;
+  }
+  return std::make_shared<file_mapping>(static_cast<const char *>(view),
+                                        length);
+}
+
+file_mapping::~file_mapping() {
+  if (data != nullptr) {
+    ::munmap(const_cast<char *>(data), size);
+  }
+}
+#endif
+
+void mmap_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("find"),
+              std::make_shared<function>(mmap_file::mmap_find));
+  map->insert(std::make_shared<string>("rfind"),
+              std::make_shared<function>(mmap_file::mmap_rfind));
+  map->insert(std::make_shared<string>("size"),
+              std::make_shared<function>(mmap_file::mmap_size));
+  map->insert(std::make_shared<string>("close"),
+              std::make_shared<function>(mmap_file::mmap_close));
+  set_dict(map);
+
+  set_name("mmap");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<string> mmap_klass::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto mmap_obj = std::static_pointer_cast<mmap_file>(obj);
+  if (mmap_obj->is_closed()) {
+    return std::make_shared<string>("<mmap.mmap closed=True>");
+  }
+  return std::make_shared<string>(std::format(
+      "<mmap.mmap closed=False, access=ACCESS_READ, length={}>",
+      mmap_obj->size()));
+}
+
+/// @brief the bytes of an mmap, bytearray or str argument, not copied.
+/// Another type raises TypeError and a closed mmap ValueError.
+static std::optional<std::string_view>
+bytes_of(const std::shared_ptr<object> &x) {
+  auto k = x->get_klass();
+  if (k == mmap_klass::get_instance()) {
+    auto mmap_obj = std::static_pointer_cast<mmap_file>(x);
+    if (!mmap_obj->check_open()) {
+      return std::nullopt;
+    }
+    return mmap_obj->view();
+  }
+  if (k == bytearray_klass::get_instance()) {
+    return std::static_pointer_cast<bytearray>(x)->view();
+  }
+  if (k != string_klass::get_instance()) {
+    raise_error(exception_klass::type_error,
+                std::format("a bytes-like object is required, not '{}'",
+                            k->get_name()));
+    return std::nullopt;
+  }
+  return std::static_pointer_cast<string>(x)->get_value();
+}
+
+std::shared_ptr<object> mmap_klass::equal(std::shared_ptr<object> x,
+                                          std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  if (y->get_klass() != this &&
+      y->get_klass() != bytearray_klass::get_instance()) {
+    return static_value::false_value;
+  }
+  auto p = bytes_of(x);
+  auto q = bytes_of(y);
+  if (!p || !q) {
+    return nullptr;
+  }
+  return static_value::get_bool_value(*p == *q);
+}
+
+std::shared_ptr<object> mmap_klass::subscr(std::shared_ptr<object> x,
+                                           std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto mmap_obj = std::static_pointer_cast<mmap_file>(x);
+  if (!mmap_obj->check_open()) {
+    return nullptr;
+  }
+  auto bytes = mmap_obj->view();
+
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto bounds = std::static_pointer_cast<slice>(y)->indices(bytes.size());
+    if (!bounds) {
+      return nullptr;
+    }
+    auto &b = *bounds;
+    if (b.step == 1) {
+      // a contiguous slice is another window on the mapping
+      return mmap_obj->slice(b.start, b.start + b.length);
+    }
+    return bytearray::from_slice(bytes, b);
+  }
+
+  auto index = sequence_index("mmap", y, bytes.size());
+  if (!index) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(static_cast<unsigned char>(bytes[*index]));
+}
+
+void mmap_klass::store_subscr(std::shared_ptr<object> x,
+                              std::shared_ptr<object> y,
+                              std::shared_ptr<object> z) {
+  raise_error(exception_klass::type_error,
+              "mmap can't modify a readonly memory map.");
+}
+
+std::shared_ptr<object> mmap_klass::len(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto mmap_obj = std::static_pointer_cast<mmap_file>(x);
+  if (!mmap_obj->check_open()) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(static_cast<int>(mmap_obj->size()));
+}
+
+mmap_file::mmap_file(std::shared_ptr<file_mapping> mapping, size_t offset,
+                     size_t length)
+    : mapping{std::move(mapping)}, offset{offset}, length{length} {
+  set_klass(mmap_klass::get_instance());
+}
+
+std::shared_ptr<mmap_file> mmap_file::map(int fd, size_t length) {
+  auto mapping = file_mapping::map(fd, length);
+  if (!mapping) {
+    return nullptr;
+  }
+  auto size = mapping->size;
+  return std::make_shared<mmap_file>(std::move(mapping), 0, size);
+}
+
+bool mmap_file::check_open() const {
+  if (is_closed()) {
+    raise_error(exception_klass::value_error, "mmap closed or invalid");
+    return false;
+  }
+  return true;
+}
+
+std::string_view mmap_file::view() const {
+  return {mapping->data + offset, length};
+}
+
+std::shared_ptr<mmap_file> mmap_file::slice(size_t start, size_t stop) const {
+  stop = std::min(stop, length);
+  start = std::min(start, stop);
+  return std::make_shared<mmap_file>(mapping, offset + start, stop - start);
+}
+
+/// @brief the mmap receiver of an mmap method
+static std::shared_ptr<mmap_file>
+self_mmap(const std::vector<std::shared_ptr<object>> &args) {
+  auto arg_0 = args.at(0);
+  assert(arg_0->get_klass() == mmap_klass::get_instance());
+  return std::static_pointer_cast<mmap_file>(arg_0);
+}
+
+/// @brief the [start, end) bounds of find and rfind, clamped like slices.
+/// nullopt when a bound isn't an int, with TypeError raised.
+static std::optional<std::pair<size_t, size_t>>
+search_bounds(const std::vector<std::shared_ptr<object>> &args, size_t size) {
+  auto bound = [&](size_t i, long long fallback) -> std::optional<size_t> {
+    long long v = fallback;
+    if (args.size() > i && args[i] != static_value::none_value) {
+      if (args[i]->get_klass() != integer_klass::get_instance()) {
+        raise_error(exception_klass::type_error,
+                    "slice indices must be integers or None or have an "
+                    "__index__ method");
+        return std::nullopt;
+      }
+      v = std::static_pointer_cast<integer>(args[i])->get_value();
+    }
+    if (v < 0) {
+      v += static_cast<long long>(size);
+    }
+    return static_cast<size_t>(
+        std::clamp<long long>(v, 0, static_cast<long long>(size)));
+  };
+  auto start = bound(2, 0);
+  auto end = bound(3, static_cast<long long>(size));
+  if (!start || !end) {
+    return std::nullopt;
+  }
+  return std::pair{*start, *end};
+}
+
+/// @brief the bytes, needle and bounds of a find or rfind call, nullopt when
+/// one of them raised
+static std::optional<
+    std::tuple<std::string_view, std::string_view, size_t, size_t>>
+search_args(const std::vector<std::shared_ptr<object>> &args) {
+  auto mmap_obj = self_mmap(args);
+  if (!mmap_obj->check_open()) {
+    return std::nullopt;
+  }
+  auto bytes = mmap_obj->view();
+  auto needle = bytes_of(args.at(1));
+  if (!needle) {
+    return std::nullopt;
+  }
+  auto bounds = search_bounds(args, bytes.size());
+  if (!bounds) {
+    return std::nullopt;
+  }
+  return std::tuple{bytes, *needle, bounds->first, bounds->second};
+}
+
+std::shared_ptr<object> mmap_file::mmap_find(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto search = search_args(*args);
+  if (!search) {
+    return nullptr;
+  }
+  auto [bytes, needle, start, end] = *search;
+
+  auto pos = start <= end ? kernels::find(bytes.substr(0, end), needle, start)
+                          : kernels::npos;
+  return std::make_shared<integer>(
+      pos == kernels::npos ? -1 : static_cast<int>(pos));
+}
+
+std::shared_ptr<object> mmap_file::mmap_rfind(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto search = search_args(*args);
+  if (!search) {
+    return nullptr;
+  }
+  auto [bytes, needle, start, end] = *search;
+
+  auto pos = std::string_view::npos;
+  if (start <= end) {
+    pos = bytes.substr(start, end - start).rfind(needle);
+  }
+  return std::make_shared<integer>(
+      pos == std::string_view::npos ? -1 : static_cast<int>(start + pos));
+}
+
+std::shared_ptr<object> mmap_file::mmap_size(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto mmap_obj = self_mmap(*args);
+  if (!mmap_obj->check_open()) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(static_cast<int>(mmap_obj->size()));
+}
+
+std::shared_ptr<object> mmap_file::mmap_close(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  self_mmap(*args)->close();
+  return static_value::none_value;
+}
+
+/// @brief mmap(fileno, length=0), always mapped read-only
+static std::shared_ptr<object>
+mmap_new(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  dict::pop_keyword_args(*args);
+
+  for (const auto &arg : *args) {
+    if (arg->get_klass() != integer_klass::get_instance()) {
+      return raise_error(
+          exception_klass::type_error,
+          std::format("'{}' object cannot be interpreted as an integer",
+                      arg->get_klass()->get_name()));
+    }
+  }
+
+  auto fileno = std::static_pointer_cast<integer>(args->at(0))->get_value();
+  int length = 0;
+  if (args->size() > 1) {
+    length = std::static_pointer_cast<integer>(args->at(1))->get_value();
+  }
+  if (length < 0) {
+    return raise_error(exception_klass::overflow_error,
+                       "memory mapped length must be positive");
+  }
+  return mmap_file::map(fileno, length);
+}
+
+static ext_method mmap_methods[] = {
+    {.method_name = "mmap",
+     .method_func = mmap_new,
+     .method_info = 0,
+     .method_doc = "mmap(fileno, length=0), a read-only map of the file"},
+    {.method_func = nullptr, .method_info = 0}};
+
+ext_method *cppython::init_libmmap() { return mmap_methods; }
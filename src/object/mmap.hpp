@@ -0,0 +1,78 @@
+#pragma once
+
+#include "inc/cppython.hpp"
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+class mmap_klass : public klass, public singleton<mmap_klass> {
+  friend class singleton<mmap_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> equal(std::shared_ptr<object> x,
+                                std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> subscr(std::shared_ptr<object> x,
+                                 std::shared_ptr<object> y) override;
+
+  /// @brief maps are read-only, a store raises TypeError
+  void store_subscr(std::shared_ptr<object> x, std::shared_ptr<object> y,
+                    std::shared_ptr<object> z) override;
+
+  std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+};
+
+class file_mapping;
+
+/// @brief a read-only window onto a memory mapped file. The bytes are never
+/// copied: find scans the mapping in place and a slice is another window
+/// onto the same mapping, which stays mapped until its last window is gone.
+class mmap_file : public object {
+public:
+  mmap_file(std::shared_ptr<file_mapping> mapping, size_t offset,
+            size_t length);
+
+  /// @brief maps length bytes of the open descriptor fd, the whole file when
+  /// length is 0. Raises ValueError for a length past the end of the file and
+  /// OSError when the file can't be mapped, and returns nullptr.
+  static std::shared_ptr<mmap_file> map(int fd, size_t length);
+
+  bool is_closed() const { return mapping == nullptr; }
+  /// @brief raises ValueError and returns false when closed. view and slice
+  /// are only called on an open map.
+  bool check_open() const;
+  size_t size() const { return length; }
+  std::string_view view() const;
+  /// @brief the window [start, stop) of this one, sharing the mapping
+  std::shared_ptr<mmap_file> slice(size_t start, size_t stop) const;
+  void close() { mapping.reset(); }
+
+  static std::shared_ptr<object>
+  mmap_find(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  mmap_rfind(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  mmap_size(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  mmap_close(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+private:
+  std::shared_ptr<file_mapping> mapping;
+  size_t offset;
+  size_t length;
+};
+
+/// @brief methods of the mmap module, imported like an extension library
+ext_method *init_libmmap();
+
+} // namespace cppython
@@ -52,6 +52,18 @@ std::shared_ptr<object> object::mod(std::shared_ptr<object> x) {
   return get_klass()->mod(shared_from_this(), x);
 }
 
+std::shared_ptr<object> object::bit_and(std::shared_ptr<object> x) {
+  return get_klass()->bit_and(shared_from_this(), x);
+}
+
+std::shared_ptr<object> object::bit_or(std::shared_ptr<object> x) {
+  return get_klass()->bit_or(shared_from_this(), x);
+}
+
+std::shared_ptr<object> object::bit_xor(std::shared_ptr<object> x) {
+  return get_klass()->bit_xor(shared_from_this(), x);
+}
+
 std::shared_ptr<object> object::greater(std::shared_ptr<object> x) {
   return get_klass()->greater(shared_from_this(), x);
 }
@@ -106,6 +118,8 @@ std::shared_ptr<object> object::contains(std::shared_ptr<object> x) {
   return get_klass()->contains(shared_from_this(), x);
 }
 
+size_t object::hash() { return get_klass()->hash(shared_from_this()); }
+
 std::shared_ptr<object> object::iter() {
   return get_klass()->iter(shared_from_this());
 }
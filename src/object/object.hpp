@@ -33,6 +33,10 @@ public:
   std::shared_ptr<object> div(std::shared_ptr<object> x);
   std::shared_ptr<object> mod(std::shared_ptr<object> x);
 
+  std::shared_ptr<object> bit_and(std::shared_ptr<object> x);
+  std::shared_ptr<object> bit_or(std::shared_ptr<object> x);
+  std::shared_ptr<object> bit_xor(std::shared_ptr<object> x);
+
   std::shared_ptr<object> greater(std::shared_ptr<object> x);
   std::shared_ptr<object> less(std::shared_ptr<object> x);
   std::shared_ptr<object> equal(std::shared_ptr<object> x);
@@ -52,6 +56,8 @@ public:
 
   std::shared_ptr<object> contains(std::shared_ptr<object> x);
 
+  size_t hash();
+
   std::shared_ptr<object> iter();
   std::shared_ptr<object> next();
   std::shared_ptr<object> len();
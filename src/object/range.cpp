@@ -0,0 +1,134 @@
+#include "object/range.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/integer.hpp"
+#include "object/slice.hpp"
+#include "object/string.hpp"
+#include "runtime/static_value.hpp"
+
+#include <cassert>
+#include <climits>
+#include <format>
+
+using namespace cppython;
+
+void range_klass::initialize() {
+  set_dict(std::make_shared<dict>());
+  set_name("range");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<string> range_klass::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto r = std::static_pointer_cast<range>(obj);
+
+  if (r->get_step() == 1) {
+    return std::make_shared<string>(
+        std::format("range({}, {})", r->get_start(), r->get_stop()));
+  }
+  return std::make_shared<string>(std::format(
+      "range({}, {}, {})", r->get_start(), r->get_stop(), r->get_step()));
+}
+
+std::shared_ptr<object> range_klass::subscr(std::shared_ptr<object> x,
+                                            std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto r = std::static_pointer_cast<range>(x);
+  auto index = sequence_index("range", y, static_cast<size_t>(r->size()));
+  if (!index) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(r->at(static_cast<long long>(*index)));
+}
+
+std::shared_ptr<object> range_klass::contains(std::shared_ptr<object> x,
+                                              std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  if (y->get_klass() != integer_klass::get_instance()) {
+    return static_value::false_value;
+  }
+
+  auto r = std::static_pointer_cast<range>(x);
+  return static_value::get_bool_value(
+      r->has_value(std::static_pointer_cast<integer>(y)->get_value()));
+}
+
+std::shared_ptr<object> range_klass::iter(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::make_shared<range_iterator>(*std::static_pointer_cast<range>(x));
+}
+
+std::shared_ptr<object> range_klass::len(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto size = std::static_pointer_cast<range>(x)->size();
+  if (size > INT_MAX) {
+    return raise_error(exception_klass::overflow_error,
+                       "Python int too large to convert to C int");
+  }
+  return std::make_shared<integer>(static_cast<int>(size));
+}
+
+std::shared_ptr<object> range_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  assert(args && args->size() >= 1 && args->size() <= 3);
+
+  int values[3];
+  for (size_t i{0}; i < args->size(); ++i) {
+    assert(args->at(i)->get_klass() == integer_klass::get_instance());
+    values[i] = std::static_pointer_cast<integer>(args->at(i))->get_value();
+  }
+
+  switch (args->size()) {
+  case 1:
+    return std::make_shared<range>(0, values[0], 1);
+  case 2:
+    return std::make_shared<range>(values[0], values[1], 1);
+  default:
+    return std::make_shared<range>(values[0], values[1], values[2]);
+  }
+}
+
+range::range(int start, int stop, int step)
+    : start{start}, stop{stop}, step{step} {
+  assert(step != 0 && "range() arg 3 must not be zero");
+  set_klass(range_klass::get_instance());
+}
+
+long long range::size() const {
+  long long lo = start, hi = stop, n = step;
+  if (n > 0 && lo < hi) {
+    return (hi - lo - 1) / n + 1;
+  }
+  if (n < 0 && lo > hi) {
+    return (lo - hi - 1) / -n + 1;
+  }
+  return 0;
+}
+
+bool range::has_value(int x) const {
+  if (step > 0 ? (x < start || x >= stop) : (x > start || x <= stop)) {
+    return false;
+  }
+  return (static_cast<long long>(x) - start) % step == 0;
+}
+
+range_iterator_klass::range_iterator_klass() {
+  set_name("range_iterator");
+  set_dict(std::make_shared<dict>());
+}
+
+std::shared_ptr<object> range_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto iter_obj = std::static_pointer_cast<range_iterator>(x);
+  if (iter_obj->exhausted()) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(iter_obj->advance());
+}
+
+range_iterator::range_iterator(const range &r)
+    : cur{r.get_start()}, step{r.get_step()}, remaining{r.size()} {
+  set_klass(range_iterator_klass::get_instance());
+}
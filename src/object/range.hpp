@@ -0,0 +1,90 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace cppython {
+
+class range_klass : public klass, public singleton<range_klass> {
+  friend class singleton<range_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> subscr(std::shared_ptr<object> x,
+                                 std::shared_ptr<object> y) override;
+  std::shared_ptr<object> contains(std::shared_ptr<object> x,
+                                   std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
+  std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+
+  /// @brief range(stop), range(start, stop[, step])
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+/// @brief lazy arithmetic progression, only start, stop and step are stored
+class range : public object {
+public:
+  range(int start, int stop, int step);
+
+  int get_start() const { return start; }
+  int get_stop() const { return stop; }
+  int get_step() const { return step; }
+
+  /// @brief the number of values, in long long since stop - start can
+  /// overflow int
+  long long size() const;
+  int at(long long index) const {
+    return static_cast<int>(start + index * step);
+  }
+  bool has_value(int x) const;
+
+private:
+  int start;
+  int stop;
+  int step;
+};
+
+class range_iterator_klass : public klass,
+                             public singleton<range_iterator_klass> {
+  friend class singleton<range_iterator_klass>;
+
+private:
+  range_iterator_klass();
+
+public:
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+};
+
+class range_iterator : public object {
+public:
+  range_iterator(const range &r);
+
+  [[nodiscard]] bool exhausted() const { return remaining == 0; }
+
+  /// @brief returns the current value and steps forward, the caller must check
+  /// exhausted() first
+  int advance() {
+    int r = cur;
+    cur += step;
+    remaining--;
+    return r;
+  }
+
+private:
+  int cur;
+  int step;
+  long long remaining;
+};
+
+} // namespace cppython
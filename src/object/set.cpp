@@ -0,0 +1,570 @@
+#include "object/set.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/integer.hpp"
+#include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/interpreter.hpp"
+#include "runtime/static_value.hpp"
+
+#include <bit>
+#include <cassert>
+#include <optional>
+
+using namespace cppython;
+
+constexpr size_t min_set_capacity = 8;
+
+/// @brief set after hashing an unhashable key
+static bool hash_failed() {
+  return interpreter::get_instance()->has_pending_exception();
+}
+
+void set_klass_base::initialize_methods(std::shared_ptr<dict> map) {
+  map->insert(std::make_shared<string>("union"),
+              std::make_shared<function>(set::set_union));
+  map->insert(std::make_shared<string>("intersection"),
+              std::make_shared<function>(set::set_intersection));
+  map->insert(std::make_shared<string>("difference"),
+              std::make_shared<function>(set::set_difference));
+  map->insert(std::make_shared<string>("copy"),
+              std::make_shared<function>(set::set_copy));
+}
+
+std::shared_ptr<string> set_klass_base::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto set_obj = std::static_pointer_cast<set>(obj);
+
+  if (set_obj->empty()) {
+    return std::make_shared<string>(get_name() + "()");
+  }
+
+  std::string result;
+  if (this == frozenset_klass::get_instance()) {
+    result += "frozenset(";
+  }
+  result += "{";
+
+  bool first = true;
+  set_obj->for_each([&](const std::shared_ptr<object> &e) {
+    if (!first) {
+      result += ", ";
+    }
+    first = false;
+    if (e->get_klass() == string_klass::get_instance()) {
+      result += "'" + e->str()->get_value() + "'";
+    } else {
+      result += e->str()->get_value();
+    }
+  });
+
+  result += "}";
+  if (this == frozenset_klass::get_instance()) {
+    result += ")";
+  }
+  return std::make_shared<string>(std::move(result));
+}
+
+std::shared_ptr<object> set_klass_base::equal(std::shared_ptr<object> x,
+                                              std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  if (!set::is_set(y)) {
+    return static_value::false_value;
+  }
+
+  auto set_x = std::static_pointer_cast<set>(x);
+  auto set_y = std::static_pointer_cast<set>(y);
+  if (set_x->size() != set_y->size()) {
+    return static_value::false_value;
+  }
+
+  bool result = true;
+  set_x->for_each([&](const std::shared_ptr<object> &e) {
+    result = result && set_y->has(e);
+  });
+  return static_value::get_bool_value(result);
+}
+
+std::shared_ptr<object> set_klass_base::not_equal(std::shared_ptr<object> x,
+                                                  std::shared_ptr<object> y) {
+  return static_value::get_bool_value(equal(x, y) ==
+                                      static_value::false_value);
+}
+
+std::shared_ptr<object> set_klass_base::sub(std::shared_ptr<object> x,
+                                            std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this && set::is_set(y));
+  return set_sub(std::static_pointer_cast<set>(x),
+                 std::static_pointer_cast<set>(y));
+}
+
+std::shared_ptr<object> set_klass_base::bit_and(std::shared_ptr<object> x,
+                                                std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this && set::is_set(y));
+  return set_and(std::static_pointer_cast<set>(x),
+                 std::static_pointer_cast<set>(y));
+}
+
+std::shared_ptr<object> set_klass_base::bit_or(std::shared_ptr<object> x,
+                                               std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this && set::is_set(y));
+  return set_or(std::static_pointer_cast<set>(x),
+                std::static_pointer_cast<set>(y));
+}
+
+std::shared_ptr<object> set_klass_base::bit_xor(std::shared_ptr<object> x,
+                                                std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this && set::is_set(y));
+  return set_xor(std::static_pointer_cast<set>(x),
+                 std::static_pointer_cast<set>(y));
+}
+
+std::shared_ptr<object> set_klass_base::contains(std::shared_ptr<object> x,
+                                                 std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  return static_value::get_bool_value(std::static_pointer_cast<set>(x)->has(y));
+}
+
+std::shared_ptr<object> set_klass_base::iter(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::make_shared<set_iterator>(std::static_pointer_cast<set>(x));
+}
+
+std::shared_ptr<object> set_klass_base::len(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto set_obj = std::static_pointer_cast<set>(x);
+  return std::make_shared<integer>(static_cast<int>(set_obj->size()));
+}
+
+void set_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("add"),
+              std::make_shared<function>(set::set_add));
+  map->insert(std::make_shared<string>("remove"),
+              std::make_shared<function>(set::set_remove));
+  map->insert(std::make_shared<string>("discard"),
+              std::make_shared<function>(set::set_discard));
+  map->insert(std::make_shared<string>("clear"),
+              std::make_shared<function>(set::set_clear));
+  map->insert(std::make_shared<string>("update"),
+              std::make_shared<function>(set::set_update));
+  initialize_methods(map);
+  set_dict(map);
+
+  set_name("set");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+size_t set_klass::hash(std::shared_ptr<object> x) {
+  return unhashable(x);
+}
+
+std::shared_ptr<object> set_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto result = std::make_shared<set>(this);
+  if (args && args->size() > 0 && !result->update(args->at(0))) {
+    return nullptr;
+  }
+  return result;
+}
+
+void frozenset_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  initialize_methods(map);
+  set_dict(map);
+
+  set_name("frozenset");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+size_t frozenset_klass::hash(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto set_obj = std::static_pointer_cast<set>(x);
+
+  // order independent, the same mixing as cpython's frozenset hash
+  size_t h = 1927868237UL * (set_obj->size() + 1);
+  set_obj->for_each([&h](const std::shared_ptr<object> &e) {
+    size_t eh = e->hash();
+    h ^= (eh ^ (eh << 16) ^ 89869747UL) * 3644798167UL;
+  });
+  return h * 69069U + 907133923UL;
+}
+
+std::shared_ptr<object> frozenset_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto result = std::make_shared<set>(this);
+  if (args && args->size() > 0 && !result->update(args->at(0))) {
+    return nullptr;
+  }
+  return result;
+}
+
+set::set(klass *k) {
+  set_klass(k == nullptr ? set_klass::get_instance() : k);
+}
+
+bool set::is_set(const std::shared_ptr<object> &x) {
+  return x->get_klass() == set_klass::get_instance() ||
+         x->get_klass() == frozenset_klass::get_instance();
+}
+
+size_t set::find_slot(const std::shared_ptr<object> &key, size_t h) {
+  const size_t mask = table.size() - 1;
+  size_t i = h & mask;
+  size_t perturb = h;
+  std::optional<size_t> free_slot;
+
+  while (true) {
+    auto &e = table[i];
+    if (e.state == slot_state::empty) {
+      return free_slot.value_or(i);
+    }
+    if (e.state == slot_state::deleted) {
+      if (!free_slot) {
+        free_slot = i;
+      }
+    } else if (e.hash == h && (e.key == key || value_equal{}(e.key, key))) {
+      return i;
+    }
+
+    perturb >>= 5;
+    i = (i * 5 + 1 + perturb) & mask;
+  }
+}
+
+void set::insert_new(const std::shared_ptr<object> &key, size_t h) {
+  const size_t mask = table.size() - 1;
+  size_t i = h & mask;
+  size_t perturb = h;
+  while (table[i].state != slot_state::empty) {
+    perturb >>= 5;
+    i = (i * 5 + 1 + perturb) & mask;
+  }
+  table[i] = {h, key, slot_state::active};
+  used++;
+  fill++;
+}
+
+void set::rehash(size_t new_capacity) {
+  new_capacity = std::bit_ceil(std::max(new_capacity, min_set_capacity));
+
+  auto old_table = std::move(table);
+  table.assign(new_capacity, entry{});
+  used = 0;
+  fill = 0;
+  for (auto &e : old_table) {
+    if (e.state == slot_state::active) {
+      insert_new(e.key, e.hash);
+    }
+  }
+}
+
+bool set::has(const std::shared_ptr<object> &key) {
+  if (used == 0) {
+    return false;
+  }
+  auto h = key->hash();
+  if (hash_failed()) {
+    return false;
+  }
+  return table[find_slot(key, h)].state == slot_state::active;
+}
+
+bool set::add(const std::shared_ptr<object> &key) {
+  auto h = key->hash();
+  if (hash_failed()) {
+    return false;
+  }
+  if (table.empty()) {
+    rehash(min_set_capacity);
+  }
+
+  auto &e = table[find_slot(key, h)];
+  if (e.state == slot_state::active) {
+    return true;
+  }
+  if (e.state == slot_state::empty) {
+    fill++;
+  }
+  e = {h, key, slot_state::active};
+  used++;
+
+  // keep the load factor (deleted slots included) under 2/3
+  if (fill * 3 >= table.size() * 2) {
+    rehash(used > 50000 ? used * 2 : used * 4);
+  }
+  return true;
+}
+
+bool set::discard(const std::shared_ptr<object> &key) {
+  if (used == 0) {
+    return false;
+  }
+
+  auto h = key->hash();
+  if (hash_failed()) {
+    return false;
+  }
+  auto &e = table[find_slot(key, h)];
+  if (e.state != slot_state::active) {
+    return false;
+  }
+  e.key.reset();
+  e.state = slot_state::deleted;
+  used--;
+  return true;
+}
+
+bool set::update(const std::shared_ptr<object> &iterable) {
+  if (is_set(iterable)) {
+    auto other = std::static_pointer_cast<set>(iterable);
+    reserve(used + other->size());
+    other->for_each([this](const std::shared_ptr<object> &e) { add(e); });
+    return true;
+  }
+
+  auto iter = iterable->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    if (!add(v)) {
+      return false;
+    }
+  }
+  return !interpreter::get_instance()->has_pending_exception();
+}
+
+void set::clear() {
+  table.clear();
+  used = 0;
+  fill = 0;
+}
+
+void set::reserve(size_t cnt) {
+  if (cnt * 3 >= table.size() * 2) {
+    rehash(cnt * 2);
+  }
+}
+
+std::shared_ptr<set> set::copy(klass *k) {
+  auto result = std::make_shared<set>(k);
+  result->table = table;
+  result->used = used;
+  result->fill = fill;
+  return result;
+}
+
+std::shared_ptr<set> cppython::set_or(std::shared_ptr<set> x,
+                                      std::shared_ptr<set> y) {
+  auto k = x->get_klass();
+  if (x->size() < y->size()) {
+    std::swap(x, y);
+  }
+
+  auto result = x->copy(k);
+  result->reserve(x->size() + y->size());
+  y->for_each([&result](const std::shared_ptr<object> &e) { result->add(e); });
+  return result;
+}
+
+std::shared_ptr<set> cppython::set_and(std::shared_ptr<set> x,
+                                       std::shared_ptr<set> y) {
+  auto result = std::make_shared<set>(x->get_klass());
+  if (x->size() > y->size()) {
+    std::swap(x, y);
+  }
+
+  x->for_each([&](const std::shared_ptr<object> &e) {
+    if (y->has(e)) {
+      result->add(e);
+    }
+  });
+  return result;
+}
+
+std::shared_ptr<set> cppython::set_sub(std::shared_ptr<set> x,
+                                       std::shared_ptr<set> y) {
+  // remove the few elements of y from a copy of x
+  if (y->size() < x->size()) {
+    auto result = x->copy(x->get_klass());
+    y->for_each([&result](const std::shared_ptr<object> &e) {
+      result->discard(e);
+    });
+    return result;
+  }
+
+  auto result = std::make_shared<set>(x->get_klass());
+  x->for_each([&](const std::shared_ptr<object> &e) {
+    if (!y->has(e)) {
+      result->add(e);
+    }
+  });
+  return result;
+}
+
+std::shared_ptr<set> cppython::set_xor(std::shared_ptr<set> x,
+                                       std::shared_ptr<set> y) {
+  auto k = x->get_klass();
+  if (x->size() < y->size()) {
+    std::swap(x, y);
+  }
+
+  auto result = x->copy(k);
+  y->for_each([&](const std::shared_ptr<object> &e) {
+    if (x->has(e)) {
+      result->discard(e);
+    } else {
+      result->add(e);
+    }
+  });
+  return result;
+}
+
+/// @brief sets are used as they are, other iterables are collected first.
+/// nullptr when collecting raised.
+static std::shared_ptr<set> as_set(const std::shared_ptr<object> &x) {
+  if (set::is_set(x)) {
+    return std::static_pointer_cast<set>(x);
+  }
+  auto result = std::make_shared<set>();
+  if (!result->update(x)) {
+    return nullptr;
+  }
+  return result;
+}
+
+std::shared_ptr<object>
+set::set_add(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == set_klass::get_instance());
+  if (!std::static_pointer_cast<set>(arg_0)->add(args->at(1))) {
+    return nullptr;
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object>
+set::set_remove(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == set_klass::get_instance());
+  if (!std::static_pointer_cast<set>(arg_0)->discard(args->at(1))) {
+    if (hash_failed()) {
+      return nullptr;
+    }
+    return raise_error(exception_klass::key_error, args->at(1));
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object>
+set::set_discard(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == set_klass::get_instance());
+  std::static_pointer_cast<set>(arg_0)->discard(args->at(1));
+  if (hash_failed()) {
+    return nullptr;
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object>
+set::set_clear(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == set_klass::get_instance());
+  std::static_pointer_cast<set>(arg_0)->clear();
+  return static_value::none_value;
+}
+
+std::shared_ptr<object>
+set::set_update(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == set_klass::get_instance());
+  auto set_obj = std::static_pointer_cast<set>(arg_0);
+  for (auto i = args->begin() + 1; i != args->end(); ++i) {
+    if (!set_obj->update(*i)) {
+      return nullptr;
+    }
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object>
+set::set_union(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(is_set(arg_0));
+  auto result = std::static_pointer_cast<set>(arg_0);
+  result = result->copy(result->get_klass());
+  for (auto i = args->begin() + 1; i != args->end(); ++i) {
+    if (!result->update(*i)) {
+      return nullptr;
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<object> set::set_intersection(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(is_set(arg_0));
+  auto result = std::static_pointer_cast<set>(arg_0);
+  result = result->copy(result->get_klass());
+  for (auto i = args->begin() + 1; i != args->end(); ++i) {
+    auto other = as_set(*i);
+    if (!other) {
+      return nullptr;
+    }
+    result = set_and(result, other);
+  }
+  return result;
+}
+
+std::shared_ptr<object> set::set_difference(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(is_set(arg_0));
+  auto result = std::static_pointer_cast<set>(arg_0);
+  result = result->copy(result->get_klass());
+  for (auto i = args->begin() + 1; i != args->end(); ++i) {
+    auto other = as_set(*i);
+    if (!other) {
+      return nullptr;
+    }
+    result = set_sub(result, other);
+  }
+  return result;
+}
+
+std::shared_ptr<object>
+set::set_copy(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(is_set(arg_0));
+  auto set_obj = std::static_pointer_cast<set>(arg_0);
+  return set_obj->copy(set_obj->get_klass());
+}
+
+set_iterator_klass::set_iterator_klass() {
+  set_name("set_iterator");
+  set_dict(std::make_shared<dict>());
+}
+
+std::shared_ptr<object> set_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto iter_obj = std::static_pointer_cast<set_iterator>(x);
+  auto owner = iter_obj->get_owner();
+
+  for (auto slot = iter_obj->get_slot(); slot < owner->capacity(); ++slot) {
+    if (auto key = owner->key_at(slot); key != nullptr) {
+      iter_obj->set_slot(slot + 1);
+      return key;
+    }
+  }
+  iter_obj->set_slot(owner->capacity());
+  return nullptr;
+}
+
+set_iterator::set_iterator(std::shared_ptr<set> owner) : owner{owner} {
+  set_klass(set_iterator_klass::get_instance());
+}
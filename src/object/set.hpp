@@ -0,0 +1,177 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cppython {
+
+/// @brief operations shared by set and frozenset
+class set_klass_base : public klass {
+public:
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> equal(std::shared_ptr<object> x,
+                                std::shared_ptr<object> y) override;
+  std::shared_ptr<object> not_equal(std::shared_ptr<object> x,
+                                    std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> sub(std::shared_ptr<object> x,
+                              std::shared_ptr<object> y) override;
+  std::shared_ptr<object> bit_and(std::shared_ptr<object> x,
+                                  std::shared_ptr<object> y) override;
+  std::shared_ptr<object> bit_or(std::shared_ptr<object> x,
+                                 std::shared_ptr<object> y) override;
+  std::shared_ptr<object> bit_xor(std::shared_ptr<object> x,
+                                  std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> contains(std::shared_ptr<object> x,
+                                   std::shared_ptr<object> y) override;
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
+  std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+
+protected:
+  void initialize_methods(std::shared_ptr<dict> map);
+};
+
+class set_klass : public set_klass_base, public singleton<set_klass> {
+  friend class singleton<set_klass>;
+
+public:
+  void initialize();
+
+  size_t hash(std::shared_ptr<object> x) override;
+
+  /// @brief set([iterable])
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+class frozenset_klass : public set_klass_base,
+                        public singleton<frozenset_klass> {
+  friend class singleton<frozenset_klass>;
+
+public:
+  void initialize();
+
+  size_t hash(std::shared_ptr<object> x) override;
+
+  /// @brief frozenset([iterable])
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+/// @brief open addressing hash table of objects, probed like cpython's set
+/// with a perturbed sequence. The klass is either set or frozenset.
+class set : public object {
+  enum class slot_state : std::uint8_t { empty, active, deleted };
+
+  struct entry {
+    size_t hash{0};
+    std::shared_ptr<object> key;
+    slot_state state{slot_state::empty};
+  };
+
+public:
+  set(klass *k = nullptr);
+
+  [[nodiscard]] static bool is_set(const std::shared_ptr<object> &x);
+
+  size_t size() const { return used; }
+  [[nodiscard]] bool empty() const { return used == 0; }
+
+  /// @brief an unhashable key raises TypeError and makes these return false
+  [[nodiscard]] bool has(const std::shared_ptr<object> &key);
+  bool add(const std::shared_ptr<object> &key);
+  bool discard(const std::shared_ptr<object> &key);
+  bool update(const std::shared_ptr<object> &iterable);
+  void clear();
+  void reserve(size_t cnt);
+
+  /// @brief shallow copy of the table, no element is rehashed
+  std::shared_ptr<set> copy(klass *k);
+
+  template <typename Func>
+  void for_each(Func f) {
+    for (const auto &e : table) {
+      if (e.state == slot_state::active) {
+        f(e.key);
+      }
+    }
+  }
+
+  // slot based access, used by set_iterator
+  size_t capacity() const { return table.size(); }
+  std::shared_ptr<object> key_at(size_t slot) {
+    return table[slot].state == slot_state::active ? table[slot].key : nullptr;
+  }
+
+  static std::shared_ptr<object>
+  set_add(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_remove(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_discard(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_clear(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_update(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_union(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_intersection(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_difference(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  set_copy(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+private:
+  size_t find_slot(const std::shared_ptr<object> &key, size_t h);
+  void insert_new(const std::shared_ptr<object> &key, size_t h);
+  void rehash(size_t new_capacity);
+
+private:
+  std::vector<entry> table;
+  size_t used{0}; // active slots
+  size_t fill{0}; // active and deleted slots
+};
+
+/// @brief set algebra, the result takes the klass of x. Each operation walks
+/// the smaller operand where the semantics allow it.
+std::shared_ptr<set> set_or(std::shared_ptr<set> x, std::shared_ptr<set> y);
+std::shared_ptr<set> set_and(std::shared_ptr<set> x, std::shared_ptr<set> y);
+std::shared_ptr<set> set_sub(std::shared_ptr<set> x, std::shared_ptr<set> y);
+std::shared_ptr<set> set_xor(std::shared_ptr<set> x, std::shared_ptr<set> y);
+
+class set_iterator_klass : public klass, public singleton<set_iterator_klass> {
+  friend class singleton<set_iterator_klass>;
+
+private:
+  set_iterator_klass();
+
+public:
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+};
+
+class set_iterator : public object {
+public:
+  set_iterator(std::shared_ptr<set> owner);
+
+  auto get_owner() { return owner; }
+  size_t get_slot() { return slot; }
+  void set_slot(size_t x) { slot = x; }
+
+private:
+  std::shared_ptr<set> owner;
+  size_t slot{0};
+};
+
+} // namespace cppython
@@ -0,0 +1,187 @@
+#include "object/slice.hpp"
+#include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/integer.hpp"
+#include "object/string.hpp"
+#include "object/tuple.hpp"
+#include "runtime/function.hpp"
+#include "runtime/static_value.hpp"
+
+#include <cassert>
+#include <format>
+#include <optional>
+
+using namespace cppython;
+
+void slice_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("indices"),
+              std::make_shared<function>(slice::slice_indices));
+  set_dict(map);
+
+  set_name("slice");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<string> slice_klass::repr(std::shared_ptr<object> obj) {
+  assert(obj && obj->get_klass() == this);
+  auto s = std::static_pointer_cast<slice>(obj);
+  return std::make_shared<string>(std::format(
+      "slice({}, {}, {})", s->get_start()->repr()->get_value(),
+      s->get_stop()->repr()->get_value(), s->get_step()->repr()->get_value()));
+}
+
+std::shared_ptr<object> slice_klass::equal(std::shared_ptr<object> x,
+                                           std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  if (y->get_klass() != this) {
+    return static_value::false_value;
+  }
+
+  auto p = std::static_pointer_cast<slice>(x);
+  auto q = std::static_pointer_cast<slice>(y);
+  value_equal eq;
+  return static_value::get_bool_value(eq(p->get_start(), q->get_start()) &&
+                                      eq(p->get_stop(), q->get_stop()) &&
+                                      eq(p->get_step(), q->get_step()));
+}
+
+size_t slice_klass::hash(std::shared_ptr<object> x) {
+  return unhashable(x);
+}
+
+std::shared_ptr<object> slice_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  assert(args && args->size() >= 1 && args->size() <= 3);
+
+  switch (args->size()) {
+  case 1:
+    return std::make_shared<slice>(static_value::none_value, args->at(0),
+                                   static_value::none_value);
+  case 2:
+    return std::make_shared<slice>(args->at(0), args->at(1),
+                                   static_value::none_value);
+  default:
+    return std::make_shared<slice>(args->at(0), args->at(1), args->at(2));
+  }
+}
+
+slice::slice(std::shared_ptr<object> start, std::shared_ptr<object> stop,
+             std::shared_ptr<object> step)
+    : start{std::move(start)}, stop{std::move(stop)}, step{std::move(step)} {
+  set_klass(slice_klass::get_instance());
+}
+
+/// @brief reads the int value of a slice part into v, nullopt for None.
+/// Any other type raises TypeError and returns false.
+static bool part_value(const std::shared_ptr<object> &x,
+                       std::optional<long long> &v) {
+  if (x == static_value::none_value) {
+    v = std::nullopt;
+    return true;
+  }
+  if (x->get_klass() != integer_klass::get_instance()) {
+    raise_error(exception_klass::type_error,
+                "slice indices must be integers or None or have an "
+                "__index__ method");
+    return false;
+  }
+  v = std::static_pointer_cast<integer>(x)->get_value();
+  return true;
+}
+
+std::optional<size_t> cppython::sequence_index(std::string_view type_name,
+                                               const std::shared_ptr<object> &y,
+                                               size_t size,
+                                               std::string_view action) {
+  if (y->get_klass() != integer_klass::get_instance()) {
+    raise_error(exception_klass::type_error,
+                std::format("{} indices must be integers or slices, not {}",
+                            type_name, y->get_klass()->get_name()));
+    return std::nullopt;
+  }
+  long long index = std::static_pointer_cast<integer>(y)->get_value();
+  auto n = static_cast<long long>(size);
+  if (index < 0) {
+    index += n;
+  }
+  if (index < 0 || index >= n) {
+    raise_error(exception_klass::index_error,
+                std::format("{} {} out of range", type_name, action));
+    return std::nullopt;
+  }
+  return static_cast<size_t>(index);
+}
+
+std::optional<slice_bounds> slice::indices(size_t size) const {
+  std::optional<long long> start_part, stop_part, step_part;
+  if (!part_value(start, start_part) || !part_value(stop, stop_part) ||
+      !part_value(step, step_part)) {
+    return std::nullopt;
+  }
+
+  auto n = static_cast<long long>(size);
+  long long step_value = step_part.value_or(1);
+  if (step_value == 0) {
+    raise_error(exception_klass::value_error, "slice step cannot be zero");
+    return std::nullopt;
+  }
+
+  // a negative bound counts from the end, then both are clamped so a
+  // backwards slice may stop one before the first item
+  auto clamp = [n, step_value](std::optional<long long> v, long long dflt) {
+    if (!v) {
+      return dflt;
+    }
+    auto r = *v < 0 ? *v + n : *v;
+    if (r < 0) {
+      return step_value < 0 ? -1LL : 0LL;
+    }
+    if (r >= n) {
+      return step_value < 0 ? n - 1 : n;
+    }
+    return r;
+  };
+  auto start_value = clamp(start_part, step_value < 0 ? n - 1 : 0);
+  auto stop_value = clamp(stop_part, step_value < 0 ? -1 : n);
+
+  long long length = 0;
+  if (step_value > 0 && start_value < stop_value) {
+    length = (stop_value - start_value - 1) / step_value + 1;
+  } else if (step_value < 0 && stop_value < start_value) {
+    length = (start_value - stop_value - 1) / -step_value + 1;
+  }
+
+  return slice_bounds{.start = static_cast<int>(start_value),
+                      .stop = static_cast<int>(stop_value),
+                      .step = static_cast<int>(step_value),
+                      .length = static_cast<size_t>(length)};
+}
+
+std::shared_ptr<object> slice::slice_indices(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == slice_klass::get_instance());
+  auto arg_1 = args->at(1);
+  if (arg_1->get_klass() != integer_klass::get_instance()) {
+    return raise_error(
+        exception_klass::type_error,
+        std::format("'{}' object cannot be interpreted as an integer",
+                    arg_1->get_klass()->get_name()));
+  }
+
+  auto size = std::static_pointer_cast<integer>(arg_1)->get_value();
+  if (size < 0) {
+    return raise_error(exception_klass::value_error,
+                       "length should not be negative");
+  }
+  auto b = std::static_pointer_cast<slice>(arg_0)->indices(size);
+  if (!b) {
+    return nullptr;
+  }
+  return tuple::create({std::make_shared<integer>(b->start),
+                        std::make_shared<integer>(b->stop),
+                        std::make_shared<integer>(b->step)});
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+class slice_klass : public klass, public singleton<slice_klass> {
+  friend class singleton<slice_klass>;
+
+public:
+  void initialize();
+
+  std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
+
+  std::shared_ptr<object> equal(std::shared_ptr<object> x,
+                                std::shared_ptr<object> y) override;
+
+  size_t hash(std::shared_ptr<object> x) override;
+
+  /// @brief slice(stop), slice(start, stop[, step])
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+/// @brief the items a slice selects from a sequence of a given size: start,
+/// start + step, ... for length items. With step 1 they are one contiguous
+/// range.
+struct slice_bounds {
+  int start;
+  int stop;
+  int step;
+  size_t length;
+};
+
+/// @brief the position an int subscript y selects in a sequence of size
+/// items, negative ones counting from the end. Otherwise TypeError or
+/// IndexError is raised and nullopt returned. action names the operation in
+/// the IndexError, "index" or "assignment index".
+std::optional<size_t> sequence_index(std::string_view type_name,
+                                     const std::shared_ptr<object> &y,
+                                     size_t size,
+                                     std::string_view action = "index");
+
+/// @brief a[start:stop:step], each part an int or None
+class slice : public object {
+public:
+  slice(std::shared_ptr<object> start, std::shared_ptr<object> stop,
+        std::shared_ptr<object> step);
+
+  const std::shared_ptr<object> &get_start() const { return start; }
+  const std::shared_ptr<object> &get_stop() const { return stop; }
+  const std::shared_ptr<object> &get_step() const { return step; }
+
+  /// @brief clamps the slice to a sequence of size items, like
+  /// slice.indices(size). A part that isn't an int or None raises TypeError
+  /// and a zero step ValueError, and nullopt is returned.
+  std::optional<slice_bounds> indices(size_t size) const;
+
+  static std::shared_ptr<object>
+  slice_indices(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+private:
+  std::shared_ptr<object> start;
+  std::shared_ptr<object> stop;
+  std::shared_ptr<object> step;
+};
+
+} // namespace cppython
@@ -1,13 +1,19 @@
 #include "object/string.hpp"
 #include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/format.hpp"
 #include "object/integer.hpp"
+#include "object/list.hpp"
+#include "object/slice.hpp"
 #include "runtime/function.hpp"
 #include "runtime/static_value.hpp"
 #include "runtime/string_table.hpp"
+#include "utils/string_kernels.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <print>
+#include <vector>
 
 using namespace cppython;
 
@@ -17,12 +23,36 @@ void string_klass::initialize() {
 
   string_dict->insert(std::make_shared<string>("upper"),
                       std::make_shared<function>(string::string_upper));
+  string_dict->insert(std::make_shared<string>("lower"),
+                      std::make_shared<function>(string::string_lower));
+  string_dict->insert(std::make_shared<string>("find"),
+                      std::make_shared<function>(string::string_find));
+  string_dict->insert(std::make_shared<string>("count"),
+                      std::make_shared<function>(string::string_count));
+  string_dict->insert(std::make_shared<string>("split"),
+                      std::make_shared<function>(string::string_split));
+  string_dict->insert(std::make_shared<string>("replace"),
+                      std::make_shared<function>(string::string_replace));
+  string_dict->insert(std::make_shared<string>("startswith"),
+                      std::make_shared<function>(string::string_startswith));
+  string_dict->insert(std::make_shared<string>("endswith"),
+                      std::make_shared<function>(string::string_endswith));
+  string_dict->insert(std::make_shared<string>("strip"),
+                      std::make_shared<function>(string::string_strip));
+  string_dict->insert(std::make_shared<string>("lstrip"),
+                      std::make_shared<function>(string::string_lstrip));
+  string_dict->insert(std::make_shared<string>("rstrip"),
+                      std::make_shared<function>(string::string_rstrip));
+  string_dict->insert(std::make_shared<string>("format"),
+                      std::make_shared<function>(string::string_format));
   string_dict->insert(std::make_shared<string>("join"),
                       std::make_shared<function>(string::string_join));
   string_dict->insert(string_table::get_instance()->repr_str,
                       std::make_shared<function>(string::string_repr));
   set_dict(string_dict);
 
+  string::initialize_char_table();
+
   set_name("str");
   std::make_shared<type>()->set_own_klass(this);
   add_super(object_klass::get_instance());
@@ -60,8 +90,13 @@ std::shared_ptr<object> string_klass::equal(std::shared_ptr<object> x,
   assert(p && (p->get_klass() == this));
   assert(q && (q->get_klass() == this));
 
-  auto r = p->get_value() <=> q->get_value();
-  return static_value::get_bool_value(std::is_eq(r));
+  if (p == q) {
+    return static_value::true_value;
+  }
+  if (p->size() != q->size() || p->hash_value() != q->hash_value()) {
+    return static_value::false_value;
+  }
+  return static_value::get_bool_value(p->get_value() == q->get_value());
 }
 
 std::shared_ptr<object> string_klass::less(std::shared_ptr<object> x,
@@ -85,20 +120,37 @@ std::shared_ptr<object> string_klass::less(std::shared_ptr<object> x,
 std::shared_ptr<object> string_klass::subscr(std::shared_ptr<object> x,
                                              std::shared_ptr<object> y) {
   assert(x->get_klass() == this);
-  assert(y->get_klass() == integer_klass::get_instance());
-
   auto string_obj = std::static_pointer_cast<string>(x);
-  auto index_obj = std::static_pointer_cast<integer>(y);
 
-  auto ch = string_obj->at(index_obj->get_value());
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto b = std::static_pointer_cast<slice>(y)->indices(string_obj->length());
+    if (!b) {
+      return nullptr;
+    }
+    return string_obj->substring(*b);
+  }
+
+  auto index = sequence_index("string", y, string_obj->length());
+  if (!index) {
+    return nullptr;
+  }
+  return string_obj->char_at(*index);
+}
 
-  return std::make_shared<string>(1, ch);
+std::shared_ptr<object> string_klass::iter(std::shared_ptr<object> x) {
+  assert(x->get_klass() == this);
+  return std::make_shared<string_iterator>(std::static_pointer_cast<string>(x));
 }
 
 std::shared_ptr<object> string_klass::len(std::shared_ptr<object> x) {
   assert(x->get_klass() == this);
   auto string_obj = std::static_pointer_cast<string>(x);
-  return std::make_shared<integer>(static_cast<int>(string_obj->size()));
+  return std::make_shared<integer>(static_cast<int>(string_obj->length()));
+}
+
+size_t string_klass::hash(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::static_pointer_cast<string>(x)->hash_value();
 }
 
 std::shared_ptr<object> string_klass::allocate_instance(
@@ -106,64 +158,396 @@ std::shared_ptr<object> string_klass::allocate_instance(
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
   if (!args || args->size() == 0) {
     return std::make_shared<string>("");
-  } else {
-    return nullptr;
   }
+  return args->at(0)->str();
+}
+
+/// @brief byte width of the UTF-8 sequence starting with lead
+static size_t utf8_width(unsigned char lead) {
+  if (lead < 0x80) {
+    return 1;
+  }
+  if (lead < 0xE0) {
+    return 2;
+  }
+  return lead < 0xF0 ? 3 : 4;
+}
+
+static size_t count_code_points(std::string_view s) {
+  // every byte except UTF-8 continuation bytes starts a code point
+  return std::ranges::count_if(s, [](char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+  });
+}
+
+void string::initialize_char_table() {
+  for (size_t i = 0; i < char_table.size(); i++) {
+    char_table[i] = std::make_shared<string>(1, static_cast<char>(i));
+  }
+}
+
+size_t string::hash_value() const {
+  if (!hash_cache) {
+    hash_cache = std::hash<std::string>{}(value);
+  }
+  return *hash_cache;
+}
+
+bool string::is_ascii() const {
+  if (!ascii_cache) {
+    ascii_cache = std::ranges::all_of(
+        value, [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+  }
+  return *ascii_cache;
+}
+
+size_t string::length() const {
+  if (is_ascii()) {
+    return value.size();
+  }
+  return count_code_points(value);
+}
+
+std::shared_ptr<string> string::char_at(size_t index) const {
+  if (is_ascii()) {
+    return from_char(value.at(index));
+  }
+
+  size_t pos = 0;
+  while (index-- > 0) {
+    pos += utf8_width(value.at(pos));
+  }
+  auto width = utf8_width(value.at(pos));
+  return width == 1 ? from_char(value[pos])
+                    : std::make_shared<string>(value, pos, width);
+}
+
+std::shared_ptr<string> string::substring(const slice_bounds &b) {
+  if (b.step == 1 && b.length == length()) {
+    return std::static_pointer_cast<string>(shared_from_this());
+  }
+  if (b.length == 1) {
+    return char_at(b.start);
+  }
+
+  if (is_ascii()) {
+    if (b.step == 1) {
+      return std::make_shared<string>(value, b.start, b.length);
+    }
+    std::string result(b.length, '\0');
+    for (size_t i = 0; i < b.length; i++) {
+      result[i] = value[b.start + i * b.step];
+    }
+    return std::make_shared<string>(std::move(result));
+  }
+
+  // byte offset of every code point, plus the end
+  std::vector<size_t> offsets;
+  offsets.reserve(value.size() + 1);
+  for (size_t pos = 0; pos < value.size(); pos += utf8_width(value[pos])) {
+    offsets.push_back(pos);
+  }
+  offsets.push_back(value.size());
+
+  if (b.step == 1) {
+    auto begin = offsets[b.start];
+    return std::make_shared<string>(value, begin,
+                                    offsets[b.start + b.length] - begin);
+  }
+  std::string result;
+  for (size_t i = 0; i < b.length; i++) {
+    size_t index = b.start + i * b.step;
+    result.append(value, offsets[index], offsets[index + 1] - offsets[index]);
+  }
+  return std::make_shared<string>(std::move(result));
 }
 
 std::shared_ptr<string> string::join(std::shared_ptr<object> iterable) {
+  // collect the parts first so the result is sized and allocated once, and
+  // one-shot iterators are only walked once
+  std::vector<std::shared_ptr<string>> parts;
   auto iter = iterable->iter();
-  auto obj = iter->next();
+  std::shared_ptr<object> obj;
+  size_t total = 0;
+  while ((obj = iter->next()) != nullptr) {
+    assert(obj->get_klass() == string_klass::get_instance());
+    parts.push_back(std::static_pointer_cast<string>(obj));
+    total += parts.back()->size();
+  }
 
-  if (obj == nullptr) {
+  if (parts.empty()) {
     return std::make_shared<string>("");
   }
-  auto str = std::static_pointer_cast<string>(obj);
-  size_t total = str->size();
-  while ((obj = iter->next()) != nullptr) {
-    total += this->size();
-    str = std::static_pointer_cast<string>(obj);
-    total += str->size();
+  if (parts.size() == 1) {
+    return parts.front();
   }
+  total += value.size() * (parts.size() - 1);
 
   std::string result;
   result.resize(total);
 
-  iter = iterable->iter();
-  obj = iter->next();
-  str = std::static_pointer_cast<string>(obj);
+  auto i = std::ranges::copy(parts.front()->get_value(), result.begin()).out;
+  for (auto p = parts.begin() + 1; p != parts.end(); ++p) {
+    i = std::ranges::copy(value, i).out;
+    i = std::ranges::copy((*p)->get_value(), i).out;
+  }
 
-  auto i = std::copy(str->get_value().begin(), str->get_value().end(),
-                     result.begin());
+  return std::make_shared<string>(std::move(result));
+}
 
-  while ((obj = iter->next()) != nullptr) {
-    str = std::static_pointer_cast<string>(obj);
-    i = std::copy(value.begin(), value.end(), i);
-    i = std::copy(str->get_value().begin(), str->get_value().end(), i);
+/// @brief the string receiver of a str method
+static std::shared_ptr<string>
+self_string(const std::vector<std::shared_ptr<object>> &args) {
+  auto arg_0 = args.at(0);
+  assert(arg_0->get_klass() == string_klass::get_instance());
+  return std::static_pointer_cast<string>(arg_0);
+}
+
+/// @brief the string argument at index
+static std::string_view
+string_arg(const std::vector<std::shared_ptr<object>> &args, size_t index) {
+  auto arg = args.at(index);
+  assert(arg->get_klass() == string_klass::get_instance());
+  return std::static_pointer_cast<string>(arg)->get_value();
+}
+
+/// @brief the optional int argument at index, dflt when absent or None
+static int int_arg(const std::vector<std::shared_ptr<object>> &args,
+                   size_t index, int dflt) {
+  if (args.size() <= index || args[index] == static_value::none_value) {
+    return dflt;
   }
+  assert(args[index]->get_klass() == integer_klass::get_instance());
+  return std::static_pointer_cast<integer>(args[index])->get_value();
+}
 
-  return std::make_shared<string>(std::move(result));
+/// @brief code point index of byte offset pos
+static int code_point_index(const string &s, size_t pos) {
+  if (s.is_ascii()) {
+    return static_cast<int>(pos);
+  }
+  return static_cast<int>(
+      count_code_points(std::string_view{s.get_value()}.substr(0, pos)));
+}
+
+/// @brief byte offset of code point index, which is at most the length
+static size_t byte_offset(const string &s, size_t index) {
+  if (s.is_ascii()) {
+    return index;
+  }
+  auto &value = s.get_value();
+  size_t pos = 0;
+  while (index-- > 0) {
+    pos += utf8_width(value[pos]);
+  }
+  return pos;
 }
 
 std::shared_ptr<object> string::string_upper(
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto arg_0 = args->at(0);
-  assert(arg_0->get_klass() == string_klass::get_instance());
+  auto str_obj = self_string(*args);
+  std::string result(str_obj->size(), '\0');
+  kernels::to_upper(str_obj->get_value().data(), result.data(), result.size());
+  return std::make_shared<string>(std::move(result));
+}
 
-  auto str_obj = std::static_pointer_cast<string>(arg_0);
+std::shared_ptr<object> string::string_lower(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto str_obj = self_string(*args);
+  std::string result(str_obj->size(), '\0');
+  kernels::to_lower(str_obj->get_value().data(), result.data(), result.size());
+  return std::make_shared<string>(std::move(result));
+}
+
+std::shared_ptr<object> string::string_find(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto str_obj = self_string(*args);
+  std::string_view value = str_obj->get_value();
+
+  // start is a code point index, negative ones counting from the end
+  long long start = int_arg(*args, 2, 0);
+  auto n = static_cast<long long>(str_obj->length());
+  if (start < 0) {
+    start = std::max(start + n, 0LL);
+  }
+  if (start > n) {
+    return std::make_shared<integer>(-1);
+  }
 
-  auto length = str_obj->size();
-  if (length <= 0) {
-    return static_value::none_value;
+  auto pos = kernels::find(value, string_arg(*args, 1),
+                           byte_offset(*str_obj, start));
+  if (pos == kernels::npos) {
+    return std::make_shared<integer>(-1);
   }
+  return std::make_shared<integer>(code_point_index(*str_obj, pos));
+}
 
-  std::string upper_str;
-  upper_str.resize(length);
+std::shared_ptr<object> string::string_count(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto str_obj = self_string(*args);
+  auto sub = string_arg(*args, 1);
+  // the empty string matches between every pair of code points
+  auto n = sub.empty() ? str_obj->length() + 1
+                       : kernels::count(str_obj->get_value(), sub);
+  return std::make_shared<integer>(static_cast<int>(n));
+}
 
-  std::transform(str_obj->get_value().begin(), str_obj->get_value().end(),
-                 upper_str.begin(), ::toupper);
+std::shared_ptr<object> string::string_split(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  std::string_view value = self_string(*args)->get_value();
+  auto max_split = int_arg(*args, 2, -1);
+  auto result = std::make_shared<list>();
+
+  // split() without a separator splits on runs of whitespace
+  if (args->size() < 2 || args->at(1) == static_value::none_value) {
+    size_t i = 0;
+    while (true) {
+      while (i < value.size() && kernels::is_space(value[i])) {
+        i++;
+      }
+      if (i == value.size()) {
+        break;
+      }
+      if (max_split-- == 0) {
+        // the rest is kept as it is, trailing whitespace included
+        result->append(std::make_shared<string>(value.substr(i)));
+        break;
+      }
+      auto j = i;
+      while (j < value.size() && !kernels::is_space(value[j])) {
+        j++;
+      }
+      result->append(std::make_shared<string>(value.substr(i, j - i)));
+      i = j;
+    }
+    return result;
+  }
 
-  return std::make_shared<string>(std::move(upper_str));
+  auto sep = string_arg(*args, 1);
+  if (sep.empty()) {
+    return raise_error(exception_klass::value_error, "empty separator");
+  }
+
+  size_t i = 0;
+  for (size_t pos = kernels::find(value, sep);
+       pos != kernels::npos && max_split-- != 0;
+       pos = kernels::find(value, sep, i)) {
+    result->append(std::make_shared<string>(value.substr(i, pos - i)));
+    i = pos + sep.size();
+  }
+  result->append(std::make_shared<string>(value.substr(i)));
+  return result;
+}
+
+std::shared_ptr<object> string::string_replace(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto str_obj = self_string(*args);
+  std::string_view value = str_obj->get_value();
+  auto old_value = string_arg(*args, 1);
+  auto new_value = string_arg(*args, 2);
+  auto max_count = int_arg(*args, 3, -1);
+
+  if (old_value.empty()) {
+    // the empty string matches before every code point and at the end
+    std::string result;
+    size_t i = 0;
+    for (; i < value.size() && max_count != 0; i += utf8_width(value[i])) {
+      result.append(new_value);
+      result.append(value.substr(i, utf8_width(value[i])));
+      max_count--;
+    }
+    if (max_count != 0) {
+      result.append(new_value);
+    }
+    result.append(value.substr(i));
+    return std::make_shared<string>(std::move(result));
+  }
+  if (kernels::find(value, old_value) == kernels::npos) {
+    return str_obj;
+  }
+
+  std::string result;
+  result.reserve(value.size());
+  size_t i = 0;
+  for (size_t pos = kernels::find(value, old_value);
+       pos != kernels::npos && max_count-- != 0;
+       pos = kernels::find(value, old_value, i)) {
+    result.append(value.substr(i, pos - i));
+    result.append(new_value);
+    i = pos + old_value.size();
+  }
+  result.append(value.substr(i));
+  return std::make_shared<string>(std::move(result));
+}
+
+std::shared_ptr<object> string::string_startswith(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  std::string_view value = self_string(*args)->get_value();
+  return static_value::get_bool_value(value.starts_with(string_arg(*args, 1)));
+}
+
+std::shared_ptr<object> string::string_endswith(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  std::string_view value = self_string(*args)->get_value();
+  return static_value::get_bool_value(value.ends_with(string_arg(*args, 1)));
+}
+
+/// @brief shared body of strip, lstrip and rstrip
+static std::shared_ptr<object>
+strip_impl(const std::vector<std::shared_ptr<object>> &args, bool left,
+           bool right) {
+  auto str_obj = self_string(args);
+  std::string_view value = str_obj->get_value();
+
+  auto strippable = [&args](char c) {
+    if (args.size() < 2 || args[1] == static_value::none_value) {
+      return kernels::is_space(c);
+    }
+    return string_arg(args, 1).find(c) != std::string_view::npos;
+  };
+
+  size_t begin = 0;
+  size_t end = value.size();
+  while (left && begin < end && strippable(value[begin])) {
+    begin++;
+  }
+  while (right && end > begin && strippable(value[end - 1])) {
+    end--;
+  }
+
+  if (begin == 0 && end == value.size()) {
+    return str_obj;
+  }
+  return std::make_shared<string>(value.substr(begin, end - begin));
+}
+
+std::shared_ptr<object> string::string_strip(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  return strip_impl(*args, true, true);
+}
+
+std::shared_ptr<object> string::string_lstrip(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  return strip_impl(*args, true, false);
+}
+
+std::shared_ptr<object> string::string_rstrip(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  return strip_impl(*args, false, true);
+}
+
+std::shared_ptr<object> string::string_format(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto str_obj = self_string(*args);
+  auto kwargs = dict::pop_keyword_args(*args);
+  std::vector<std::shared_ptr<object>> fields{args->begin() + 1, args->end()};
+
+  std::string result;
+  result.reserve(str_obj->size() + 8 * fields.size());
+  if (!format_string_to(result, str_obj->get_value(), fields, kwargs)) {
+    return nullptr;
+  }
+  return std::make_shared<string>(std::move(result));
 }
 
 std::shared_ptr<object> string::string_join(
@@ -182,4 +566,30 @@ std::shared_ptr<object> string::string_repr(
 
   auto str_obj = std::static_pointer_cast<string>(arg_0);
   return str_obj->repr();
-}
\ No newline at end of file
+}
+
+string_iterator_klass::string_iterator_klass() {
+  set_dict(std::make_shared<dict>());
+  set_name("str_iterator");
+}
+
+std::shared_ptr<object> string_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  auto iter_obj = std::static_pointer_cast<string_iterator>(x);
+  const auto &value = iter_obj->get_owner()->get_value();
+
+  auto pos = iter_obj->get_pos();
+  if (pos >= value.size()) {
+    return nullptr;
+  }
+
+  auto width = utf8_width(value[pos]);
+  iter_obj->set_pos(pos + width);
+  return width == 1 ? string::from_char(value[pos])
+                    : std::make_shared<string>(value, pos, width);
+}
+
+string_iterator::string_iterator(std::shared_ptr<string> owner)
+    : owner{owner} {
+  set_klass(string_iterator_klass::get_instance());
+}
@@ -4,10 +4,16 @@
 #include "object/object.hpp"
 #include "utils/singleton.hpp"
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace cppython {
+
+struct slice_bounds;
+
 class string_klass : public klass, public singleton<string_klass> {
 public:
   void initialize();
@@ -24,12 +30,18 @@ public:
 
   std::shared_ptr<object> subscr(std::shared_ptr<object> x,
                                  std::shared_ptr<object> y) override;
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
   std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+
+  size_t hash(std::shared_ptr<object> x) override;
   std::shared_ptr<object> allocate_instance(
       std::shared_ptr<object> obj_type,
       std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
 };
 
+/// @brief immutable text. Short values live in the std::string's inline
+/// buffer; the hash and the ASCII flag are computed once and cached, and
+/// single characters are shared from a table of 256 preallocated strings.
 class string : public object {
 public:
   template <typename... Args>
@@ -42,10 +54,64 @@ public:
 
   const std::string &get_value() const { return value; }
 
+  /// @brief strings are immutable to python code, this is only for the
+  /// interpreter when it holds the last reference
+  void append(std::string_view x) {
+    value += x;
+    hash_cache.reset();
+    ascii_cache.reset();
+  }
+
+  size_t hash_value() const;
+  bool is_ascii() const;
+  /// @brief number of code points, the byte size for ASCII text
+  size_t length() const;
+  /// @brief the code point at index as a string
+  std::shared_ptr<string> char_at(size_t index) const;
+  /// @brief the code points selected by b, copied as one block when they are
+  /// contiguous
+  std::shared_ptr<string> substring(const slice_bounds &b);
+
+  /// @brief the shared one-character string for byte c
+  static const std::shared_ptr<string> &from_char(unsigned char c) {
+    return char_table[c];
+  }
+  static void initialize_char_table();
+
   std::shared_ptr<string> join(std::shared_ptr<object> iterable);
 
   static std::shared_ptr<object>
   string_upper(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  string_lower(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+  /// @brief find(sub[, start]), the index of sub or -1
+  static std::shared_ptr<object>
+  string_find(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  /// @brief count(sub), non-overlapping occurrences
+  static std::shared_ptr<object>
+  string_count(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  /// @brief split(sep=None, maxsplit=-1)
+  static std::shared_ptr<object>
+  string_split(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  /// @brief replace(old, new[, count])
+  static std::shared_ptr<object>
+  string_replace(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object> string_startswith(
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  string_endswith(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  /// @brief strip([chars]), whitespace when chars is absent
+  static std::shared_ptr<object>
+  string_strip(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  string_lstrip(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object>
+  string_rstrip(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+  /// @brief format(*args, **kwargs)
+  static std::shared_ptr<object>
+  string_format(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
 
   static std::shared_ptr<object>
   string_join(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
@@ -55,6 +121,35 @@ public:
 
 private:
   std::string value;
+  mutable std::optional<size_t> hash_cache;
+  mutable std::optional<bool> ascii_cache;
+
+  static inline std::array<std::shared_ptr<string>, 256> char_table;
+};
+
+class string_iterator_klass : public klass,
+                              public singleton<string_iterator_klass> {
+  friend class singleton<string_iterator_klass>;
+
+private:
+  string_iterator_klass();
+
+public:
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+};
+
+class string_iterator : public object {
+public:
+  string_iterator(std::shared_ptr<string> owner);
+
+  auto get_owner() { return owner; }
+  size_t get_pos() { return pos; }
+  void set_pos(size_t x) { pos = x; }
+
+private:
+  std::shared_ptr<string> owner;
+  size_t pos{0}; // byte offset of the next character
 };
 
 } // namespace cppython
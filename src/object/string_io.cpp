@@ -0,0 +1,77 @@
+#include "object/string_io.hpp"
+#include "object/dict.hpp"
+#include "object/integer.hpp"
+#include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/static_value.hpp"
+
+#include <cassert>
+
+using namespace cppython;
+
+void string_io_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("write"),
+              std::make_shared<function>(string_io::string_io_write));
+  map->insert(std::make_shared<string>("writelines"),
+              std::make_shared<function>(string_io::string_io_writelines));
+  map->insert(std::make_shared<string>("getvalue"),
+              std::make_shared<function>(string_io::string_io_getvalue));
+  set_dict(map);
+
+  set_name("StringIO");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
+std::shared_ptr<object> string_io_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (!args || args->size() == 0) {
+    return std::make_shared<string_io>();
+  }
+
+  auto initial = args->at(0);
+  assert(initial->get_klass() == string_klass::get_instance());
+  return std::make_shared<string_io>(
+      std::static_pointer_cast<string>(initial)->get_value());
+}
+
+string_io::string_io(std::string initial) : buffer{std::move(initial)} {
+  set_klass(string_io_klass::get_instance());
+}
+
+std::shared_ptr<object> string_io::string_io_write(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == string_io_klass::get_instance());
+  auto arg_1 = args->at(1);
+  assert(arg_1->get_klass() == string_klass::get_instance());
+
+  auto str_obj = std::static_pointer_cast<string>(arg_1);
+  std::static_pointer_cast<string_io>(arg_0)->write(str_obj->get_value());
+  return std::make_shared<integer>(static_cast<int>(str_obj->size()));
+}
+
+std::shared_ptr<object> string_io::string_io_writelines(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == string_io_klass::get_instance());
+  auto io_obj = std::static_pointer_cast<string_io>(arg_0);
+
+  auto iter = args->at(1)->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    assert(v->get_klass() == string_klass::get_instance());
+    io_obj->write(std::static_pointer_cast<string>(v)->get_value());
+  }
+  return static_value::none_value;
+}
+
+std::shared_ptr<object> string_io::string_io_getvalue(
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto arg_0 = args->at(0);
+  assert(arg_0->get_klass() == string_io_klass::get_instance());
+  return std::make_shared<string>(
+      std::static_pointer_cast<string_io>(arg_0)->get_value());
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "object/klass.hpp"
+#include "object/object.hpp"
+#include "utils/singleton.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+class string_io_klass : public klass, public singleton<string_io_klass> {
+  friend class singleton<string_io_klass>;
+
+public:
+  void initialize();
+
+  /// @brief StringIO([initial_value])
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
+};
+
+/// @brief in-memory text buffer, writes append to one growing std::string so
+/// building text piece by piece stays linear
+class string_io : public object {
+public:
+  string_io(std::string initial = {});
+
+  void write(std::string_view x) { buffer += x; }
+  const std::string &get_value() const { return buffer; }
+
+  static std::shared_ptr<object>
+  string_io_write(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object> string_io_writelines(
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  static std::shared_ptr<object> string_io_getvalue(
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+private:
+  std::string buffer;
+};
+
+} // namespace cppython
@@ -1,10 +1,17 @@
 #include "object/tuple.hpp"
 #include "object/dict.hpp"
 #include "object/integer.hpp"
+#include "object/slice.hpp"
 #include "object/string.hpp"
+#include "runtime/function.hpp"
+#include "runtime/interpreter.hpp"
 #include "runtime/static_value.hpp"
+#include "utils/free_list.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <new>
 #include <print>
 
 using namespace cppython;
@@ -41,17 +48,210 @@ std::shared_ptr<string> tuple_klass::repr(std::shared_ptr<object> obj) {
     result += fmt_str(i);
   }
 
+  if (tuple_obj->size() == 1) {
+    result += ",";
+  }
   result += ")";
   return std::make_shared<string>(std::move(result));
 }
 
+std::shared_ptr<object> tuple_klass::equal(std::shared_ptr<object> x,
+                                           std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  if (y->get_klass() != this) {
+    return static_value::false_value;
+  }
+  if (x == y) {
+    return static_value::true_value;
+  }
+
+  auto p = std::static_pointer_cast<tuple>(x);
+  auto q = std::static_pointer_cast<tuple>(y);
+  if (p->size() != q->size()) {
+    return static_value::false_value;
+  }
+  // equal tuples have equal hashes, a mismatch of hashes both already
+  // computed settles it early. Nothing is hashed here, the items may not be
+  // hashable.
+  if (auto h = p->cached_hash(), k = q->cached_hash(); h && k && *h != *k) {
+    return static_value::false_value;
+  }
+  return static_value::get_bool_value(
+      std::ranges::equal(p->get_value(), q->get_value(), value_equal{}));
+}
+
 std::shared_ptr<object> tuple_klass::subscr(std::shared_ptr<object> x,
                                             std::shared_ptr<object> y) {
   assert(x->get_klass() == this);
-  assert(y->get_klass() == integer_klass::get_instance());
-
   auto tuple_obj = std::static_pointer_cast<tuple>(x);
-  auto index_obj = std::static_pointer_cast<integer>(y);
 
-  return tuple_obj->at(index_obj->get_value());
+  if (y->get_klass() == slice_klass::get_instance()) {
+    auto items = tuple_obj->get_value();
+    auto bounds = std::static_pointer_cast<slice>(y)->indices(items.size());
+    if (!bounds) {
+      return nullptr;
+    }
+    auto &b = *bounds;
+    if (b.step == 1) {
+      // tuples are immutable, the whole range is the tuple itself
+      if (b.length == items.size()) {
+        return x;
+      }
+      return tuple::create(items.subspan(b.start, b.length));
+    }
+
+    auto result = tuple::create(b.length);
+    for (size_t i{0}; i < b.length; ++i) {
+      result->set(i, items[b.start + i * b.step]);
+    }
+    return result;
+  }
+
+  auto index = sequence_index("tuple", y, tuple_obj->size());
+  if (!index) {
+    return nullptr;
+  }
+  return tuple_obj->at(*index);
+}
+
+std::shared_ptr<object> tuple_klass::contains(std::shared_ptr<object> x,
+                                              std::shared_ptr<object> y) {
+  assert(x && x->get_klass() == this);
+  auto items = std::static_pointer_cast<tuple>(x)->get_value();
+  return static_value::get_bool_value(std::ranges::any_of(
+      items, [&y](const std::shared_ptr<object> &v) {
+        return v == y || v->equal(y) == static_value::true_value;
+      }));
+}
+
+size_t tuple_klass::hash(std::shared_ptr<object> x) {
+  assert(x->get_klass() == this);
+  return std::static_pointer_cast<tuple>(x)->hash_value();
+}
+
+std::shared_ptr<object> tuple_klass::iter(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::make_shared<tuple_iterator>(std::static_pointer_cast<tuple>(x));
+}
+
+std::shared_ptr<object> tuple_klass::len(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::make_shared<integer>(
+      static_cast<int>(std::static_pointer_cast<tuple>(x)->size()));
+}
+
+std::shared_ptr<object> tuple_klass::allocate_instance(
+    std::shared_ptr<object> obj_type,
+    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (!args || args->empty()) {
+    return tuple::create(0);
+  }
+  if (args->at(0)->get_klass() == this) {
+    return args->at(0);
+  }
+
+  std::vector<std::shared_ptr<object>> items;
+  auto iter = args->at(0)->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    items.push_back(v);
+  }
+  return tuple::create(items);
+}
+
+/// @brief the free lists of tuple blocks, one per item count. Never
+/// destroyed, tuples may still be released during static destruction.
+static free_list &tuple_pool(size_t n) {
+  static auto *pools = [] {
+    auto *r = new std::array<free_list *, tuple::max_pooled_size + 1>;
+    for (size_t i = 0; i < r->size(); i++) {
+      (*r)[i] = new free_list(
+          sizeof(tuple) + i * sizeof(std::shared_ptr<object>), 2000);
+    }
+    return r;
+  }();
+  return *(*pools)[n];
+}
+
+struct tuple::deleter {
+  void operator()(tuple *t) const {
+    auto n = t->count;
+    t->~tuple();
+    if (n <= max_pooled_size) {
+      tuple_pool(n).deallocate(t);
+    } else {
+      ::operator delete(t);
+    }
+  }
+};
+
+std::shared_ptr<tuple> tuple::create(size_t n) {
+  static_assert(sizeof(tuple) % alignof(std::shared_ptr<object>) == 0);
+
+  if (n == 0) {
+    static const auto empty = std::shared_ptr<tuple>(
+        new (tuple_pool(0).allocate()) tuple(0), deleter{},
+        free_list_allocator<tuple>{});
+    return empty;
+  }
+
+  void *block = n <= max_pooled_size
+                    ? tuple_pool(n).allocate()
+                    : ::operator new(sizeof(tuple) +
+                                     n * sizeof(std::shared_ptr<object>));
+  // the control block comes from a free list as well
+  return std::shared_ptr<tuple>(new (block) tuple(n), deleter{},
+                                free_list_allocator<tuple>{});
+}
+
+std::shared_ptr<tuple>
+tuple::create(std::span<const std::shared_ptr<object>> items) {
+  auto result = create(items.size());
+  std::ranges::copy(items, result->items());
+  return result;
+}
+
+tuple::tuple(size_t n) : count{n} {
+  std::uninitialized_value_construct_n(items(), n);
+  set_klass(tuple_klass::get_instance());
+}
+
+tuple::~tuple() { std::destroy_n(items(), count); }
+
+size_t tuple::hash_value() const {
+  if (!hash_cache) {
+    // the same mixing as boost::hash_combine
+    size_t seed = count;
+    for (const auto &e : get_value()) {
+      seed ^= e->hash() + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    // an unhashable item raised, and the next attempt has to raise again
+    if (interpreter::get_instance()->has_pending_exception()) {
+      return 0;
+    }
+    hash_cache = seed;
+  }
+  return *hash_cache;
+}
+
+tuple_iterator_klass::tuple_iterator_klass() {
+  set_name("tuple_iterator");
+  set_dict(std::make_shared<dict>());
+}
+
+std::shared_ptr<object> tuple_iterator_klass::next(std::shared_ptr<object> x) {
+  assert(x && x->get_klass() == this);
+  return std::static_pointer_cast<tuple_iterator>(x)->next();
+}
+
+tuple_iterator::tuple_iterator(std::shared_ptr<tuple> owner)
+    : owner{std::move(owner)} {
+  set_klass(tuple_iterator_klass::get_instance());
+}
+
+std::shared_ptr<object> tuple_iterator::next() {
+  if (pos >= owner->size()) {
+    return nullptr;
+  }
+  return owner->at(pos++);
 }
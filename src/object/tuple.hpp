@@ -4,7 +4,11 @@
 #include "object/object.hpp"
 #include "utils/singleton.hpp"
 
+#include <cassert>
+#include <initializer_list>
 #include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace cppython {
@@ -18,29 +22,102 @@ private:
 public:
   std::shared_ptr<string> repr(std::shared_ptr<object> obj) override;
 
+  std::shared_ptr<object> equal(std::shared_ptr<object> x,
+                                std::shared_ptr<object> y) override;
+
   std::shared_ptr<object> subscr(std::shared_ptr<object> x,
                                  std::shared_ptr<object> y) override;
+  std::shared_ptr<object> contains(std::shared_ptr<object> x,
+                                   std::shared_ptr<object> y) override;
+
+  size_t hash(std::shared_ptr<object> x) override;
+
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override;
+  std::shared_ptr<object> len(std::shared_ptr<object> x) override;
+
+  /// @brief tuple() or tuple(iterable)
+  std::shared_ptr<object> allocate_instance(
+      std::shared_ptr<object> obj_type,
+      std::shared_ptr<std::vector<std::shared_ptr<object>>> args) override;
 };
 
-class tuple : public object {
+/// @brief immutable fixed size sequence. The items are stored inline after
+/// the object in one block; blocks of tuples up to max_pooled_size items are
+/// recycled through a free list per size, and every empty tuple is the same
+/// object. Tuples are built with create() and filled once with set().
+class tuple final : public object {
 public:
-  template <typename... Args>
-  tuple(Args &&...args) : value{std::forward<Args>(args)...} {
-    set_klass(tuple_klass::get_instance());
+  static constexpr size_t max_pooled_size = 20;
+
+  /// @brief a tuple of n items, each to be filled with set()
+  static std::shared_ptr<tuple> create(size_t n);
+  static std::shared_ptr<tuple>
+  create(std::span<const std::shared_ptr<object>> items);
+  static std::shared_ptr<tuple>
+  create(std::initializer_list<std::shared_ptr<object>> items) {
+    return create(std::span{items.begin(), items.size()});
   }
 
-  const std::vector<std::shared_ptr<object>> &get_value() const {
-    return value;
+  std::span<const std::shared_ptr<object>> get_value() const {
+    return {items(), count};
   }
 
-  auto empty() { return value.empty(); }
-  auto size() { return value.size(); }
+  bool empty() const { return count == 0; }
+  size_t size() const { return count; }
+
+  const std::shared_ptr<object> &at(size_t pos) const {
+    assert(pos < count && "IndexError: tuple index out of range");
+    return items()[pos];
+  }
+  /// @brief fills item pos of a tuple being built
+  void set(size_t pos, std::shared_ptr<object> v) {
+    assert(pos < count);
+    items()[pos] = std::move(v);
+  }
+
+  /// @brief the hash of the items, computed once
+  size_t hash_value() const;
+  /// @brief the hash if it has been computed, nullopt otherwise
+  std::optional<size_t> cached_hash() const { return hash_cache; }
+
+private:
+  struct deleter;
+
+  explicit tuple(size_t n);
+  ~tuple() override;
+
+  std::shared_ptr<object> *items() {
+    return reinterpret_cast<std::shared_ptr<object> *>(this + 1);
+  }
+  const std::shared_ptr<object> *items() const {
+    return reinterpret_cast<const std::shared_ptr<object> *>(this + 1);
+  }
+
+  size_t count;
+  mutable std::optional<size_t> hash_cache;
+};
+
+class tuple_iterator_klass : public klass,
+                             public singleton<tuple_iterator_klass> {
+  friend class singleton<tuple_iterator_klass>;
+
+private:
+  tuple_iterator_klass();
+
+public:
+  std::shared_ptr<object> iter(std::shared_ptr<object> x) override { return x; }
+  std::shared_ptr<object> next(std::shared_ptr<object> x) override;
+};
+
+class tuple_iterator : public object {
+public:
+  tuple_iterator(std::shared_ptr<tuple> owner);
 
-  auto at(size_t pos) { return value.at(pos); }
-  auto append(const std::shared_ptr<object> &v) { return value.push_back(v); }
+  std::shared_ptr<object> next();
 
 private:
-  std::vector<std::shared_ptr<object>> value;
+  std::shared_ptr<tuple> owner;
+  size_t pos{0};
 };
 
 } // namespace cppython
@@ -10,6 +10,6 @@ cell_klass::cell_klass() {
   set_dict(std::make_shared<dict>());
 }
 
-cell::cell(std::shared_ptr<list> t, int i) : table{t}, index{i} {
+cell::cell(std::shared_ptr<object> x) : contents{std::move(x)} {
   set_klass(cell_klass::get_instance());
 }
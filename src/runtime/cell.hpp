@@ -1,7 +1,6 @@
 #pragma once
 
 #include "object/klass.hpp"
-#include "object/list.hpp"
 #include "object/object.hpp"
 #include "utils/singleton.hpp"
 
@@ -18,16 +17,18 @@ private:
   cell_klass();
 };
 
+/// @brief a variable shared between a function and the closures defined in
+/// it. The frame owning the variable and every closure hold the same cell.
 class cell : public object {
 public:
-  cell(std::shared_ptr<list> t, int i);
-  std::shared_ptr<object> value() {
-    { return table->at(index); }
-  }
+  explicit cell(std::shared_ptr<object> x = nullptr);
+
+  /// @brief the variable, nullptr while it is unbound
+  const std::shared_ptr<object> &get() const { return contents; }
+  void set(std::shared_ptr<object> x) { contents = std::move(x); }
 
 private:
-  std::shared_ptr<list> table;
-  int index;
+  std::shared_ptr<object> contents;
 };
 
 } // namespace cppython
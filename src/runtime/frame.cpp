@@ -1,9 +1,11 @@
 #include "runtime/frame.hpp"
+#include "code/bytecode.hpp"
 #include "code/code_object.hpp"
 #include "object/dict.hpp"
 #include "object/list.hpp"
 #include "object/string.hpp"
 #include "object/tuple.hpp"
+#include "runtime/cell.hpp"
 #include "runtime/function.hpp"
 #include "runtime/static_value.hpp"
 
@@ -16,6 +18,7 @@ frame::frame(std::shared_ptr<code_object> code) {
   codes = code;
   consts = code->consts;
   names = code->names;
+  allocate_slots(0, code->stacksize);
 
   locals = std::make_shared<dict>();
 
@@ -29,35 +32,70 @@ frame::frame(std::shared_ptr<function> func,
   consts = codes->consts;
   names = codes->names;
 
-  locals = std::make_shared<dict>();
   globals = func->get_globals();
-  fast_locals = std::make_shared<list>();
+  cell_base = codes->nlocals;
+  auto cell_cnt = codes->cell_count();
+  allocate_slots(cell_base + cell_cnt + codes->free_count(), codes->stacksize);
 
-  auto arg_cnt = codes->argcount;
+  std::shared_ptr<dict> kw_dict;
+  if (has_kw_arg) {
+    kw_dict = std::static_pointer_cast<dict>(args->back());
+    args->pop_back();
+  }
 
-  fast_locals->resize(arg_cnt);
+  if (codes->simple_signature && !kw_dict &&
+      real_arg_cnt == codes->argcount) {
+    // every parameter gets the argument in its position
+    if (real_arg_cnt > 0) {
+      assert(args && args->size() >= static_cast<size_t>(real_arg_cnt));
+      std::copy_n(args->begin(), real_arg_cnt, fast_locals.begin());
+    }
+  } else {
+    bind_args(func, args, real_arg_cnt, kw_dict);
+  }
+
+  // a new cell per cell variable, starting with the argument of the
+  // parameter it captures, then the cells of the closure are shared
+  for (size_t i = 0; i < cell_cnt; i++) {
+    auto slot = codes->cell_arg_slot(i);
+    fast_locals[cell_base + i] =
+        std::make_shared<cell>(slot >= 0 ? fast_locals[slot] : nullptr);
+  }
+  if (codes->free_count() > 0) {
+    auto free_cells = func->get_closure()->get_value();
+    assert(free_cells.size() == codes->free_count());
+    std::copy(free_cells.begin(), free_cells.end(),
+              fast_locals.begin() + cell_base + cell_cnt);
+  }
+}
+
+void frame::allocate_slots(size_t fast_cnt, size_t stack_size) {
+  slots = std::make_unique<std::shared_ptr<object>[]>(fast_cnt + stack_size);
+  fast_locals = {slots.get(), fast_cnt};
+  data_stack = value_stack{slots.get() + fast_cnt, stack_size};
+}
+
+void frame::bind_args(
+    const std::shared_ptr<function> &func,
+    const std::shared_ptr<std::vector<std::shared_ptr<object>>> &args,
+    int real_arg_cnt, const std::shared_ptr<dict> &kw_dict) {
+  auto arg_cnt = codes->argcount;
 
   // default args
   if (auto def_args = func->get_default_args(); def_args) {
-    std::copy(def_args->rbegin(), def_args->rend(), fast_locals->rbegin());
+    std::copy_backward(def_args->begin(), def_args->end(),
+                       fast_locals.begin() + arg_cnt);
   }
 
   auto var_args = std::make_shared<list>();
   auto kw_args = std::make_shared<dict>();
 
-  std::shared_ptr<dict> kw_dict;
-
-  if (has_kw_arg) {
-    kw_dict = std::static_pointer_cast<dict>(args->back());
-    args->pop_back();
-  }
-
   if (args && args->size() > 0) {
     // positional args
     std::copy_n(
         args->begin(),
         std::min({real_arg_cnt, arg_cnt, static_cast<int>(args->size())}),
-        fast_locals->begin());
+        fast_locals.begin());
 
     // extend positional args
     if (real_arg_cnt > arg_cnt) {
@@ -67,72 +105,81 @@ frame::frame(std::shared_ptr<function> func,
     }
   }
 
-  if (has_kw_arg) {
+  if (kw_dict) {
     // keyword args
     for (const auto &[k, v] : kw_dict->get_value()) {
-      assert(codes->varnames &&
-             codes->varnames->get_klass() == tuple_klass::get_instance());
-      auto var_names = std::static_pointer_cast<tuple>(codes->varnames);
-      auto iter = std::ranges::find_if(
-          var_names->get_value(), [k](const std::shared_ptr<object> &x) {
-            return x->equal(k) == static_value::true_value;
-          });
-      if (iter != var_names->get_value().end()) {
-        auto index = std::distance(var_names->get_value().begin(), iter);
-        fast_locals->at(index) = v;
+      if (auto slot = codes->arg_slot(k); slot >= 0) {
+        fast_locals[slot] = v;
       } else {
         kw_args->insert(k, v);
       }
     }
   }
 
+  // *args and **kwargs follow the keyword-only parameters
+  size_t slot = arg_cnt + codes->kwonlyargcount;
   if (codes->flags & function::co_flags::var_args) {
-    fast_locals->append(var_args);
+    fast_locals[slot++] = var_args;
   }
   if (codes->flags & function::co_flags::var_keywords) {
-    fast_locals->append(kw_args);
+    fast_locals[slot] = kw_args;
   }
+}
 
-  auto cells = codes->cellvars;
-  assert(cells && cells->get_klass() == tuple_klass::get_instance());
-  auto tpl_cells = std::static_pointer_cast<tuple>(cells);
+int frame::get_op_arg() { return codes->code->at(pc++) & 0xFF; }
 
-  if (tpl_cells->size() > 0) {
-    closure = std::make_shared<list>();
-    closure->resize(tpl_cells->size(), nullptr);
-  }
+unsigned char frame::get_op_code() { return codes->code->at(pc++); }
 
-  if (func->get_closure() && func->get_closure()->size() > 0) {
-    if (!closure) {
-      closure = func->get_closure();
-    } else {
-      closure =
-          std::static_pointer_cast<list>(closure->add(func->get_closure()));
-    }
+std::pair<unsigned char, int> frame::peek_instruction() const {
+  // instructions are two bytes wide, pc sits on the pad byte of an op code
+  // without argument
+  size_t next = (pc + 1) & ~size_t{1};
+  if (next + 1 >= codes->code->size()) {
+    return {std::to_underlying(bytecode::NOP), 0};
   }
+  return {codes->code->at(next), codes->code->at(next + 1) & 0xFF};
 }
 
-int frame::get_op_arg() { return codes->code->at(pc++) & 0xFF; }
-
-unsigned char frame::get_op_code() { return codes->code->at(pc++); }
+const handler_entry *frame::find_handler() const {
+  if (pc == 0) {
+    return nullptr;
+  }
+  return codes->find_handler(instruction_offset());
+}
 
 bool frame::has_more_codes() const { return pc < codes->code->size(); }
 
-std::shared_ptr<object> frame::get_cell_from_parameter(int i) {
-  auto cells = codes->cellvars;
-  assert(cells && cells->get_klass() == tuple_klass::get_instance());
-  auto tpl_cells = std::static_pointer_cast<tuple>(cells);
+std::shared_ptr<dict> &frame::get_locals() {
+  if (!locals) {
+    locals = std::make_shared<dict>();
+  }
+  return locals;
+}
 
-  auto cell_name = tpl_cells->at(i);
+std::shared_ptr<dict> frame::locals_view() {
+  if (!(codes->flags & function::co_flags::optimized)) {
+    return get_locals();
+  }
 
-  auto vars = codes->varnames;
-  assert(vars && vars->get_klass() == tuple_klass::get_instance());
-  auto tpl_vars = std::static_pointer_cast<tuple>(vars);
+  auto result = std::make_shared<dict>();
+  auto var_names = std::static_pointer_cast<tuple>(codes->varnames);
+  for (size_t i = 0; i < cell_base; i++) {
+    if (fast_locals[i]) {
+      result->insert(var_names->at(i), fast_locals[i]);
+    }
+  }
 
-  auto iter = std::ranges::find_if(tpl_vars->get_value(),
-                                   std::bind_back(value_equal{}, cell_name));
-  assert(iter != tpl_vars->get_value().end());
-  return fast_locals->at(std::distance(tpl_vars->get_value().begin(), iter));
+  // then the bound cell and free variables
+  size_t i = cell_base;
+  for (const auto &names : {codes->cellvars, codes->freevars}) {
+    for (const auto &name : std::static_pointer_cast<tuple>(names)
+                                ->get_value()) {
+      if (auto &v = static_cast<cell &>(*fast_locals[i++]).get(); v) {
+        result->insert(name, v);
+      }
+    }
+  }
+  return result;
 }
 
 std::shared_ptr<string> frame::get_file_name() {
@@ -144,20 +191,5 @@ std::shared_ptr<string> frame::get_func_name() {
 }
 
 int frame::get_source_lineno() {
-  int pc_offset = 0;
-  int src_line_no = codes->firstlineno;
-
-  auto lnotab = std::static_pointer_cast<string>(codes->lnotab);
-  int length = lnotab->size();
-
-  for (int i = 0; i < length; i++) {
-    pc_offset += lnotab->at(i++);
-    if (pc_offset >= pc) {
-      return src_line_no;
-    }
-
-    src_line_no += lnotab->at(i);
-  }
-
-  return src_line_no;
+  return codes->line_of(instruction_offset());
 }
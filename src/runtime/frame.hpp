@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <memory>
-#include <stack>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace cppython {
@@ -13,11 +16,45 @@ class dict;
 class function;
 class code_object;
 class string;
+class Generator;
 
-struct loop_block {
-  unsigned char type;
-  size_t target;
-  size_t level;
+struct handler_entry;
+
+/// @brief the value stack of a frame, a view of the slots after the fast
+/// locals; indexable so that SET_ADD and friends can reach below the top
+class value_stack {
+public:
+  value_stack() = default;
+  value_stack(std::shared_ptr<object> *base, size_t capacity)
+      : base{base}, top{base}, limit{base + capacity} {}
+
+  std::shared_ptr<object> *begin() const { return base; }
+  std::shared_ptr<object> *end() const { return top; }
+  std::shared_ptr<object> *data() const { return base; }
+  size_t size() const { return top - base; }
+  bool empty() const { return top == base; }
+
+  std::shared_ptr<object> &operator[](size_t i) const { return base[i]; }
+  std::shared_ptr<object> &back() const { return top[-1]; }
+
+  void push_back(std::shared_ptr<object> v) {
+    // co_stacksize bounds the depth, the slots never grow
+    assert(top != limit);
+    *top++ = std::move(v);
+  }
+  void pop_back() { (--top)->reset(); }
+  /// @brief drops the values above the first n
+  void resize(size_t n) {
+    assert(n <= size());
+    while (size() > n) {
+      pop_back();
+    }
+  }
+
+private:
+  std::shared_ptr<object> *base{nullptr};
+  std::shared_ptr<object> *top{nullptr};
+  std::shared_ptr<object> *limit{nullptr};
 };
 
 class frame {
@@ -29,24 +66,43 @@ public:
 
   void set_caller(std::shared_ptr<frame> x) { caller = x; }
   [[nodiscard]] auto get_caller() { return caller; }
+  /// @brief the caller without taking a reference, for the profiler
+  [[nodiscard]] frame *get_caller_frame() const { return caller.get(); }
 
   void set_pc(size_t x) { pc = x; }
   [[nodiscard]] auto get_pc() { return pc; }
+  /// @brief moves pc back to the instruction being executed
+  void rewind() { pc = (pc - 1) & ~size_t{1}; }
+  /// @brief the offset of the instruction being executed
+  size_t instruction_offset() const {
+    return pc == 0 ? 0 : (pc - 1) & ~size_t{1};
+  }
+  /// @brief the innermost try block around the instruction being executed
+  const handler_entry *find_handler() const;
+
+  /// @brief the generator running this frame, nullptr for a call
+  void set_generator(Generator *x) { generator = x; }
+  [[nodiscard]] Generator *get_generator() { return generator; }
 
   void set_entry_frame(bool x) { entry = x; }
   [[nodiscard]] bool is_entry_frame() { return entry; }
   [[nodiscard]] bool is_first_frame() { return caller == nullptr; }
 
   auto &get_data_stack() { return data_stack; }
-  auto &get_loop_stack() { return loop_stack; }
   auto get_consts() { return consts; }
   auto &get_names() { return names; }
-  auto &get_locals() { return locals; }
+  /// @brief the locals dict, created on first use in a function frame
+  std::shared_ptr<dict> &get_locals();
   auto &get_globals() { return globals; }
+  /// @brief the local variables by slot, unbound ones are nullptr
   auto &get_fast_locals() { return fast_locals; }
-  auto &get_closure() { return closure; }
-  std::shared_ptr<object> get_cell_from_parameter(int i);
+  /// @brief locals(): the locals dict of a module or class body, a snapshot
+  /// of the bound fast locals of a function
+  std::shared_ptr<dict> locals_view();
+  /// @brief cell i of the cell variables followed by the free variables
+  auto &get_cell(int i) { return fast_locals[cell_base + i]; }
 
+  auto &get_code() { return codes; }
   std::shared_ptr<string> get_file_name();
   std::shared_ptr<string> get_func_name();
   int get_source_lineno();
@@ -54,22 +110,34 @@ public:
   bool has_more_codes() const;
   unsigned char get_op_code();
   int get_op_arg();
+  /// @brief op code and arg of the next instruction, nothing is consumed
+  std::pair<unsigned char, int> peek_instruction() const;
 
 private:
+  /// @brief allocates the slot block and carves the fast locals and the
+  /// value stack from it
+  void allocate_slots(size_t fast_cnt, size_t stack_size);
+  /// @brief the full binder: defaults, *args, **kwargs and keyword args
+  void bind_args(
+      const std::shared_ptr<function> &func,
+      const std::shared_ptr<std::vector<std::shared_ptr<object>>> &args,
+      int real_arg_cnt, const std::shared_ptr<dict> &kw_dict);
+
   std::shared_ptr<frame> caller;
   bool entry{false};
-
-  std::stack<std::shared_ptr<object>> data_stack;
-  std::stack<loop_block> loop_stack;
+  Generator *generator{nullptr};
 
   std::shared_ptr<code_object> codes;
 
   std::shared_ptr<tuple> consts;
   std::shared_ptr<tuple> names;
 
-  std::shared_ptr<list> fast_locals;
-
-  std::shared_ptr<list> closure;
+  // one block per frame: the nlocals local variables, the cells of the
+  // cell and free variables, then co_stacksize slots of value stack
+  std::unique_ptr<std::shared_ptr<object>[]> slots;
+  std::span<std::shared_ptr<object>> fast_locals;
+  value_stack data_stack;
+  size_t cell_base{0};
 
   std::shared_ptr<dict> locals;
   std::shared_ptr<dict> globals;
@@ -1,15 +1,22 @@
 #include "runtime/function.hpp"
 #include "code/code_object.hpp"
 #include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/file.hpp"
+#include "object/format.hpp"
+#include "object/float.hpp"
 #include "object/integer.hpp"
 #include "object/list.hpp"
 #include "object/string.hpp"
+#include "object/string_io.hpp"
 #include "runtime/interpreter.hpp"
+#include "runtime/output_stream.hpp"
 #include "runtime/static_value.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <format>
+#include <optional>
 #include <print>
 
 using namespace cppython;
@@ -55,44 +62,107 @@ function::function(native_function_t *native_func) : native_func{native_func} {
   set_klass(native_function_klass::get_instance());
 }
 
-std::shared_ptr<object>
-cppython::repr(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto arg_0 = args->at(0);
-  return arg_0->repr();
+function::function(vector_function_t *vector_func) : vector_func{vector_func} {
+  set_klass(native_function_klass::get_instance());
 }
 
-std::shared_ptr<object>
-cppython::len(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto arg_0 = args->at(0);
-  return arg_0->len();
+std::shared_ptr<object> cppython::repr(vector_args_t args) {
+  return args[0]->repr();
 }
 
-std::shared_ptr<object>
-cppython::iter(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto arg_0 = args->at(0);
-  return arg_0->len();
+std::shared_ptr<object> cppython::len(vector_args_t args) {
+  return args[0]->len();
+}
+
+std::shared_ptr<object> cppython::iter(vector_args_t args) {
+  return args[0]->iter();
+}
+
+/// @brief writes str(v) to out, ints and floats without a string object
+static void write_object(output_stream &out, const std::shared_ptr<object> &v) {
+  auto k = v->get_klass();
+  if (k == string_klass::get_instance()) {
+    out.write(std::static_pointer_cast<string>(v)->get_value());
+  } else if (k == integer_klass::get_instance()) {
+    out.write_int(std::static_pointer_cast<integer>(v)->get_value());
+  } else if (k == float_klass::get_instance()) {
+    out.write_double(std::static_pointer_cast<float_num>(v)->get_value());
+  } else {
+    out.write(v->str()->get_value());
+  }
 }
 
 std::shared_ptr<object>
 cppython::print(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  std::shared_ptr<object> sep = static_value::none_value;
+  std::shared_ptr<object> end = static_value::none_value;
+  std::shared_ptr<object> file = static_value::none_value;
+  bool flush = false;
+
+  if (auto kwargs = dict::pop_keyword_args(*args); kwargs) {
+    sep = kwargs->at(std::make_shared<string>("sep"));
+    end = kwargs->at(std::make_shared<string>("end"));
+    file = kwargs->at(std::make_shared<string>("file"));
+    flush =
+        static_value::is_true(kwargs->at(std::make_shared<string>("flush")));
+  }
+
+  auto text_of = [](const std::shared_ptr<object> &v, std::string_view dflt) {
+    if (v == static_value::none_value) {
+      return dflt;
+    }
+    assert(v->get_klass() == string_klass::get_instance());
+    return std::string_view{std::static_pointer_cast<string>(v)->get_value()};
+  };
+  auto sep_text = text_of(sep, " ");
+  auto end_text = text_of(end, "\n");
+
+  if (file == static_value::none_value) {
+    auto &out = output_stream::standard_output();
+    for (size_t i = 0; i < args->size(); i++) {
+      if (i > 0) {
+        out.write(sep_text);
+      }
+      write_object(out, args->at(i));
+    }
+    out.write(end_text);
+    if (flush) {
+      out.flush();
+    }
+    return static_value::none_value;
+  }
 
-  for (auto &e : *args) {
-    std::print("{} ", e->str()->get_value());
+  // other files get the whole line in one write call
+  std::string text;
+  for (size_t i = 0; i < args->size(); i++) {
+    if (i > 0) {
+      text += sep_text;
+    }
+    format_value_to(text, args->at(i), "");
+  }
+  text += end_text;
+
+  if (file->get_klass() == string_io_klass::get_instance()) {
+    std::static_pointer_cast<string_io>(file)->write(text);
+  } else {
+    auto write_args = std::make_shared<std::vector<std::shared_ptr<object>>>();
+    write_args->push_back(std::make_shared<string>(std::move(text)));
+    if (!interpreter::get_instance()->call_virtual(
+            file->getattr(std::make_shared<string>("write")), write_args)) {
+      return nullptr;
+    }
   }
-  std::print("\n");
   return static_value::none_value;
 }
 
-std::shared_ptr<object>
-cppython::type_of(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto arg_0 = args->at(0);
-  return arg_0->get_klass()->get_type_object();
+std::shared_ptr<object> cppython::type_of(vector_args_t args) {
+  return args[0]->get_klass()->get_type_object();
 }
 
-std::shared_ptr<object> cppython::isinstance(
-    std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
-  auto x = args->at(0);
-  auto y = args->at(1);
+std::shared_ptr<object> cppython::isinstance(vector_args_t args) {
+  assert(args.size() == 2);
+  auto &x = args[0];
+  auto &y = args[1];
 
   assert(y && y->get_klass() == type_klass::get_instance());
   auto type_obj = std::static_pointer_cast<type>(y);
@@ -100,6 +170,171 @@ std::shared_ptr<object> cppython::isinstance(
   return static_value::get_bool_value(x->isinstance(type_obj));
 }
 
+std::shared_ptr<object> cppython::locals(vector_args_t args) {
+  assert(args.empty());
+  return interpreter::get_instance()->current_locals();
+}
+
+std::shared_ptr<object>
+cppython::sum(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto iter = args->at(0)->iter();
+  std::shared_ptr<object> result =
+      args->size() > 1 ? args->at(1) : std::make_shared<integer>(0);
+
+  // integers are accumulated unboxed, only the final value is boxed
+  std::optional<int> int_sum;
+  if (result->get_klass() == integer_klass::get_instance()) {
+    int_sum = std::static_pointer_cast<integer>(result)->get_value();
+  }
+
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    if (int_sum && v->get_klass() == integer_klass::get_instance()) {
+      *int_sum += std::static_pointer_cast<integer>(v)->get_value();
+      continue;
+    }
+    if (int_sum) {
+      result = std::make_shared<integer>(*int_sum);
+      int_sum.reset();
+    }
+    result = result->add(v);
+    if (result == nullptr) {
+      return nullptr;
+    }
+  }
+
+  return int_sum ? std::make_shared<integer>(*int_sum) : result;
+}
+
+template <typename PredicateOperation>
+  requires std::predicate<PredicateOperation, const std::shared_ptr<object> &,
+                          const std::shared_ptr<object> &>
+static std::shared_ptr<object>
+min_max(std::shared_ptr<std::vector<std::shared_ptr<object>>> args,
+        PredicateOperation better) {
+  assert(args && !args->empty());
+
+  std::shared_ptr<object> result;
+  auto update = [&result, &better](const std::shared_ptr<object> &v) {
+    if (result == nullptr || better(v, result)) {
+      result = v;
+    }
+  };
+
+  if (args->size() > 1) {
+    std::ranges::for_each(*args, update);
+  } else {
+    auto iter = args->at(0)->iter();
+    std::shared_ptr<object> v;
+    while ((v = iter->next()) != nullptr) {
+      update(v);
+    }
+  }
+
+  if (interpreter::get_instance()->has_pending_exception()) {
+    return nullptr;
+  }
+  assert(result != nullptr && "arg is an empty sequence");
+  return result;
+}
+
+std::shared_ptr<object>
+cppython::min_of(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  return min_max(args, value_less{});
+}
+
+std::shared_ptr<object>
+cppython::max_of(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  return min_max(args, [](const std::shared_ptr<object> &l,
+                          const std::shared_ptr<object> &r) {
+    return r->less(l) == static_value::true_value;
+  });
+}
+
+std::shared_ptr<object>
+cppython::any(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto iter = args->at(0)->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    if (static_value::is_true(v)) {
+      return static_value::true_value;
+    }
+  }
+  return static_value::false_value;
+}
+
+std::shared_ptr<object>
+cppython::all(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto iter = args->at(0)->iter();
+  std::shared_ptr<object> v;
+  while ((v = iter->next()) != nullptr) {
+    if (!static_value::is_true(v)) {
+      return static_value::false_value;
+    }
+  }
+  return static_value::true_value;
+}
+
+std::shared_ptr<object>
+cppython::open(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  auto kwargs = dict::pop_keyword_args(*args);
+  auto name = args->at(0);
+  if (name->get_klass() != string_klass::get_instance()) {
+    return raise_error(exception_klass::type_error,
+                       std::format("expected str, not {}",
+                                   name->get_klass()->get_name()));
+  }
+
+  std::shared_ptr<object> mode = static_value::none_value;
+  if (args->size() > 1) {
+    mode = args->at(1);
+  } else if (kwargs) {
+    mode = kwargs->at(std::make_shared<string>("mode"));
+  }
+
+  std::string_view mode_text = "r";
+  if (mode != static_value::none_value) {
+    if (mode->get_klass() != string_klass::get_instance()) {
+      return raise_error(exception_klass::type_error,
+                         std::format("open() argument 'mode' must be str, "
+                                     "not {}",
+                                     mode->get_klass()->get_name()));
+    }
+    mode_text = std::static_pointer_cast<string>(mode)->get_value();
+  }
+
+  auto path = std::static_pointer_cast<string>(name)->get_value();
+  return file::open(std::string{path}, mode_text);
+}
+
+std::shared_ptr<object>
+cppython::format(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  std::string_view spec;
+  if (args->size() > 1) {
+    if (args->at(1)->get_klass() != string_klass::get_instance()) {
+      return raise_error(
+          exception_klass::type_error,
+          std::format("format() argument 2 must be str, not {}",
+                      args->at(1)->get_klass()->get_name()));
+    }
+    spec = std::static_pointer_cast<string>(args->at(1))->get_value();
+  }
+
+  std::string result;
+  if (!format_value_to(result, args->at(0), spec)) {
+    return nullptr;
+  }
+  return std::make_shared<string>(std::move(result));
+}
+
+std::shared_ptr<object> cppython::hash(vector_args_t args) {
+  auto h = args[0]->hash();
+  if (interpreter::get_instance()->has_pending_exception()) {
+    return nullptr;
+  }
+  return std::make_shared<integer>(static_cast<int>(h));
+}
+
 std::shared_ptr<object> cppython::build_class(
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
   auto arg_0 = args->at(0); // function
@@ -132,9 +367,22 @@ std::shared_ptr<object> cppython::build_class(
 
 std::shared_ptr<object>
 function::call(std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
+  if (vector_func != nullptr) {
+    return args ? (*vector_func)(*args) : (*vector_func)({});
+  }
   return (*native_func)(args);
 }
 
+std::shared_ptr<object> function::vectorcall(vector_args_t args) {
+  if (vector_func != nullptr) {
+    return (*vector_func)(args);
+  }
+  // the compatibility shim for functions taking an argument vector
+  return (*native_func)(
+      std::make_shared<std::vector<std::shared_ptr<object>>>(args.begin(),
+                                                             args.end()));
+}
+
 bool method::is_function(std::shared_ptr<object> x) {
   auto k = x->get_klass();
 
@@ -5,6 +5,7 @@
 #include "utils/singleton.hpp"
 
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 
@@ -12,6 +13,7 @@ namespace cppython {
 
 class code_object;
 class list;
+class tuple;
 class dict;
 
 class function_klass : public klass, public singleton<function_klass> {
@@ -41,23 +43,58 @@ private:
 using native_function_t = std::shared_ptr<object>(
     std::shared_ptr<std::vector<std::shared_ptr<object>>>);
 
+/// @brief arguments passed as a view of the caller's value stack
+using vector_args_t = std::span<const std::shared_ptr<object>>;
+
+/// @brief the vectorcall convention, nothing is allocated to pass the
+/// arguments. Callees must not keep the span beyond the call.
+using vector_function_t = std::shared_ptr<object>(vector_args_t);
+
+std::shared_ptr<object> repr(vector_args_t args);
+
+std::shared_ptr<object> len(vector_args_t args);
+
+std::shared_ptr<object> iter(vector_args_t args);
+
+/// @brief print(*objects, sep=' ', end='\n', file=None, flush=False)
 std::shared_ptr<object>
-repr(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+print(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+std::shared_ptr<object> type_of(vector_args_t args);
+
+std::shared_ptr<object> isinstance(vector_args_t args);
 
+/// @brief locals(), a snapshot in a function
+std::shared_ptr<object> locals(vector_args_t args);
+
+/// @brief sum(iterable, start=0)
 std::shared_ptr<object>
-len(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+sum(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
 
+/// @brief min(iterable) or min(a, b, ...)
 std::shared_ptr<object>
-iter(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+min_of(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
 
+/// @brief max(iterable) or max(a, b, ...)
 std::shared_ptr<object>
-print(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+max_of(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+std::shared_ptr<object>
+any(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
 
 std::shared_ptr<object>
-type_of(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+all(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
 
+/// @brief open(file, mode='r')
 std::shared_ptr<object>
-isinstance(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+open(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+/// @brief format(value, spec='')
+std::shared_ptr<object>
+format(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+
+/// @brief hash(obj), truncated to the width of int
+std::shared_ptr<object> hash(vector_args_t args);
 
 /// @brief build a class
 /// @param args first element is function object, second element is name, ...
@@ -70,6 +107,7 @@ class function : public object {
 
 public:
   enum co_flags {
+    optimized = 0x1,
     var_args = 0x4,
     var_keywords = 0x8,
     generator = 0x20,
@@ -78,9 +116,14 @@ public:
   function(std::shared_ptr<object> obj);
   function(klass *klass) { set_klass(klass); }
   function(native_function_t *native_func);
+  function(vector_function_t *vector_func);
 
   std::shared_ptr<object>
   call(std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
+  /// @brief calls a native function with args in place, functions of the
+  /// older convention get a copy in an argument vector
+  std::shared_ptr<object> vectorcall(vector_args_t args);
+  bool has_vectorcall() const { return vector_func != nullptr; }
 
   auto get_func_code() { return func_code; }
   auto get_func_name() { return func_name; }
@@ -96,7 +139,8 @@ public:
     default_args = x;
   }
 
-  void set_closure(const std::shared_ptr<list> &x) { closure = x; }
+  /// @brief the cells of the free variables, in freevars order
+  void set_closure(const std::shared_ptr<tuple> &x) { closure = x; }
   auto get_closure() { return closure; }
 
 private:
@@ -105,11 +149,12 @@ private:
   std::shared_ptr<dict> globals;
 
   std::shared_ptr<std::vector<std::shared_ptr<object>>> default_args;
-  std::shared_ptr<list> closure;
+  std::shared_ptr<tuple> closure;
 
   int flags{0};
 
-  native_function_t *native_func;
+  native_function_t *native_func{nullptr};
+  vector_function_t *vector_func{nullptr};
 };
 
 class method : public object {
@@ -1,24 +1,78 @@
 #include "runtime/generator.hpp"
+#include "object/dict.hpp"
+#include "object/string.hpp"
 #include "runtime/frame.hpp"
 #include "runtime/interpreter.hpp"
+#include "runtime/static_value.hpp"
 
 #include <cassert>
 
 using namespace cppython;
 
+void generator_klass::initialize() {
+  auto map = std::make_shared<dict>();
+  map->insert(std::make_shared<string>("send"),
+              std::make_shared<function>(Generator::generator_send));
+  map->insert(std::make_shared<string>("throw"),
+              std::make_shared<function>(Generator::generator_throw));
+  map->insert(std::make_shared<string>("close"),
+              std::make_shared<function>(Generator::generator_close));
+  set_dict(map);
+
+  set_name("generator");
+  std::make_shared<type>()->set_own_klass(this);
+  add_super(object_klass::get_instance());
+}
+
 std::shared_ptr<object> generator_klass::iter(std::shared_ptr<object> obj) {
   return obj;
 }
 
 std::shared_ptr<object> generator_klass::next(std::shared_ptr<object> obj) {
   assert(obj && obj->get_klass() == this);
-  auto g = std::static_pointer_cast<Generator>(obj);
-  return interpreter::get_instance()->eval_generator(g);
+  return interpreter::get_instance()->resume_generator(
+      static_cast<Generator &>(*obj), static_value::none_value);
 }
 
 Generator::Generator(std::shared_ptr<function> func,
                      std::shared_ptr<std::vector<std::shared_ptr<object>>> args,
                      int arg_cnt) {
   frm = std::make_shared<frame>(func, args, arg_cnt);
+  frm->set_generator(this);
   set_klass(generator_klass::get_instance());
 }
+
+void Generator::finish() {
+  running = false;
+  frm = nullptr;
+}
+
+/// @brief the generator receiver of a generator method
+static Generator &self_generator(vector_args_t args) {
+  assert(!args.empty() &&
+         args[0]->get_klass() == generator_klass::get_instance());
+  return static_cast<Generator &>(*args[0]);
+}
+
+std::shared_ptr<object> Generator::generator_send(vector_args_t args) {
+  assert(args.size() == 2);
+  auto interp = interpreter::get_instance();
+  auto result = interp->resume_generator(self_generator(args), args[1]);
+  if (!result && !interp->has_pending_exception()) {
+    // the generator returned
+    interp->raise(static_value::stop_iteration);
+  }
+  return result;
+}
+
+std::shared_ptr<object> Generator::generator_throw(vector_args_t args) {
+  assert(args.size() == 2);
+  return interpreter::get_instance()->throw_into_generator(
+      self_generator(args), args[1]);
+}
+
+std::shared_ptr<object> Generator::generator_close(vector_args_t args) {
+  assert(args.size() == 1);
+  interpreter::get_instance()->close_generator(self_generator(args));
+  return static_value::none_value;
+}
@@ -2,6 +2,7 @@
 
 #include "object/klass.hpp"
 #include "object/object.hpp"
+#include "runtime/function.hpp"
 
 #include <memory>
 #include <vector>
@@ -13,21 +14,36 @@ class frame;
 
 class generator_klass : public klass, public singleton<generator_klass> {
 public:
+  void initialize();
+
   std::shared_ptr<object> next(std::shared_ptr<object> obj) override;
   std::shared_ptr<object> iter(std::shared_ptr<object> obj) override;
 };
 
+/// @brief the suspended frame of a generator function. Suspending keeps the
+/// frame with its pc and value stack as they are, resuming links it back
+/// under the running frame, so FOR_ITER and YIELD_FROM resume a generator
+/// inside the dispatch loop of their own frame.
 class Generator : public object {
 public:
   Generator(std::shared_ptr<function> func,
             std::shared_ptr<std::vector<std::shared_ptr<object>>> args,
             int arg_cnt);
 
+  /// @brief the frame, nullptr once the generator has finished
   std::shared_ptr<frame> get_frame() const { return frm; }
-  void set_frame(std::shared_ptr<frame> x) { frm = x; }
+  void finish();
+
+  bool is_running() const { return running; }
+  void set_running(bool x) { running = x; }
+
+  static std::shared_ptr<object> generator_send(vector_args_t args);
+  static std::shared_ptr<object> generator_throw(vector_args_t args);
+  static std::shared_ptr<object> generator_close(vector_args_t args);
 
 private:
   std::shared_ptr<frame> frm;
+  bool running{false};
 };
 
 } // namespace cppython
@@ -1,21 +1,36 @@
 #include "runtime/interpreter.hpp"
 #include "code/bytecode.hpp"
 #include "code/code_object.hpp"
+#include "object/array.hpp"
+#include "object/bytearray.hpp"
 #include "object/dict.hpp"
+#include "object/exception.hpp"
 #include "object/float.hpp"
+#include "object/format.hpp"
 #include "object/integer.hpp"
+#include "object/iterator.hpp"
 #include "object/list.hpp"
 #include "object/object.hpp"
+#include "object/range.hpp"
+#include "object/set.hpp"
+#include "object/slice.hpp"
+#include "object/string.hpp"
+#include "object/string_io.hpp"
 #include "object/tuple.hpp"
 #include "runtime/cell.hpp"
 #include "runtime/function.hpp"
 #include "runtime/generator.hpp"
 #include "runtime/module.hpp"
+#include "runtime/output_stream.hpp"
+#include "runtime/profiler.hpp"
 #include "runtime/static_value.hpp"
 #include "runtime/string_table.hpp"
 #include "runtime/traceback.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <format>
 #include <functional>
 #include <optional>
 #include <print>
@@ -44,6 +59,24 @@ void interpreter::initialize() {
                    std::make_shared<function>(type_of));
   builtins->insert(std::make_shared<string>("isinstance"),
                    std::make_shared<function>(isinstance));
+  builtins->insert(std::make_shared<string>("locals"),
+                   std::make_shared<function>(cppython::locals));
+  builtins->insert(std::make_shared<string>("sum"),
+                   std::make_shared<function>(sum));
+  builtins->insert(std::make_shared<string>("min"),
+                   std::make_shared<function>(min_of));
+  builtins->insert(std::make_shared<string>("max"),
+                   std::make_shared<function>(max_of));
+  builtins->insert(std::make_shared<string>("any"),
+                   std::make_shared<function>(any));
+  builtins->insert(std::make_shared<string>("all"),
+                   std::make_shared<function>(all));
+  builtins->insert(std::make_shared<string>("hash"),
+                   std::make_shared<function>(hash));
+  builtins->insert(std::make_shared<string>("format"),
+                   std::make_shared<function>(format));
+  builtins->insert(std::make_shared<string>("open"),
+                   std::make_shared<function>(cppython::open));
 
   // builtin classes
   builtins->insert(std::make_shared<string>("object"),
@@ -58,15 +91,38 @@ void interpreter::initialize() {
                    list_klass::get_instance()->get_type_object());
   builtins->insert(std::make_shared<string>("dict"),
                    dict_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("array"),
+                   array_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("range"),
+                   range_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("set"),
+                   set_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("frozenset"),
+                   frozenset_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("StringIO"),
+                   string_io_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("tuple"),
+                   tuple_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("slice"),
+                   slice_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("bytearray"),
+                   bytearray_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("map"),
+                   map_iterator_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("filter"),
+                   filter_iterator_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("enumerate"),
+                   enumerate_iterator_klass::get_instance()->get_type_object());
+  builtins->insert(std::make_shared<string>("zip"),
+                   zip_iterator_klass::get_instance()->get_type_object());
+
+  for (auto k : exception_klass::builtins()) {
+    builtins->insert(std::make_shared<string>(k->get_name()),
+                     k->get_type_object());
+  }
 
   builtins->extend(Module::import(std::make_shared<string>("builtin")));
 
-  static_value::assertion_error =
-      builtins->get(std::make_shared<string>("AssertionError"));
-
-  static_value::stop_iteration =
-      builtins->get(std::make_shared<string>("StopIteration"));
-
   modules = std::make_shared<dict>();
   modules->insert(std::make_shared<string>("__builtins__"), builtins);
 }
@@ -82,8 +138,15 @@ void interpreter::run(std::shared_ptr<code_object> codes) {
   if (cur_status == status::is_exception) {
     cur_status = status::is_ok;
 
-    std::print("{}", trace_back->str()->get_value());
-    std::println("{}", pending_exception->str()->get_value());
+    // keep buffered program output ahead of the traceback
+    output_stream::standard_output().flush();
+    if (trace_back) {
+      std::print("{}", trace_back->str()->get_value());
+    }
+    std::println("{}", std::static_pointer_cast<exception_object>(
+                           pending_exception)
+                           ->describe()
+                           ->get_value());
 
     trace_back = nullptr;
     pending_exception = nullptr;
@@ -96,6 +159,7 @@ void interpreter::run(std::shared_ptr<code_object> codes) {
 std::shared_ptr<dict>
 interpreter::run_module(std::shared_ptr<code_object> codes,
                         std::shared_ptr<string> module_name) {
+  profiler::get_instance()->keep(codes);
   auto module_frame = std::make_shared<frame>(codes);
   module_frame->set_entry_frame(true);
   module_frame->get_locals()->insert(string_table::get_instance()->name_str,
@@ -108,6 +172,35 @@ interpreter::run_module(std::shared_ptr<code_object> codes,
   return result;
 }
 
+bool interpreter::is_owned_by_next_store(const std::shared_ptr<object> &w) {
+  if (w.use_count() != 2) {
+    return false;
+  }
+
+  auto [op_code, op_arg] = cur_frame->peek_instruction();
+  switch (static_cast<bytecode>(op_code)) {
+    using enum bytecode;
+  case STORE_FAST:
+    return cur_frame->get_fast_locals()[op_arg] == w;
+  case STORE_NAME:
+    return cur_frame->get_locals()
+               ->get(cur_frame->get_names()->at(op_arg), value_equal{})
+               .value_or(nullptr) == w;
+  case STORE_GLOBAL:
+    return cur_frame->get_globals()
+               ->get(cur_frame->get_names()->at(op_arg), value_equal{})
+               .value_or(nullptr) == w;
+  default:
+    return false;
+  }
+}
+
+/// @brief true when x is a native function taking its arguments in place
+static bool is_vectorcall(const std::shared_ptr<object> &x) {
+  return x->get_klass() == native_function_klass::get_instance() &&
+         static_cast<function *>(x.get())->has_vectorcall();
+}
+
 void interpreter::eval_frame() {
 
   while (cur_frame->has_more_codes()) {
@@ -169,7 +262,24 @@ void interpreter::eval_frame() {
     case BINARY_ADD: {
       auto v = pop_data();
       auto w = pop_data();
-      push_data(w->add(v));
+      // lst += x extends lst itself, binary + still builds a new list
+      if (op == INPLACE_ADD &&
+          w->get_klass() == list_klass::get_instance()) {
+        std::static_pointer_cast<list>(w)->extend(v);
+        push_data(w);
+        break;
+      }
+      // s = s + t and s += t append in place, which keeps string building
+      // loops linear
+      if (w->get_klass() == string_klass::get_instance() &&
+          v->get_klass() == string_klass::get_instance() &&
+          is_owned_by_next_store(w)) {
+        std::static_pointer_cast<string>(w)->append(
+            std::static_pointer_cast<string>(v)->get_value());
+        push_data(w);
+      } else {
+        push_data(w->add(v));
+      }
       break;
     }
     case INPLACE_SUBTRACT:
@@ -193,12 +303,51 @@ void interpreter::eval_frame() {
       push_data(w->div(v));
       break;
     }
+    case INPLACE_AND:
+    case BINARY_AND: {
+      auto v = pop_data();
+      auto w = pop_data();
+      push_data(w->bit_and(v));
+      break;
+    }
+    case INPLACE_XOR:
+    case BINARY_XOR: {
+      auto v = pop_data();
+      auto w = pop_data();
+      push_data(w->bit_xor(v));
+      break;
+    }
+    case INPLACE_OR: {
+      auto v = pop_data();
+      auto w = pop_data();
+      // a mutable set grows in place instead of being rebuilt
+      if (w->get_klass() == set_klass::get_instance() && set::is_set(v)) {
+        std::static_pointer_cast<set>(w)->update(v);
+        push_data(w);
+      } else {
+        push_data(w->bit_or(v));
+      }
+      break;
+    }
+    case BINARY_OR: {
+      auto v = pop_data();
+      auto w = pop_data();
+      push_data(w->bit_or(v));
+      break;
+    }
     case BINARY_SUBSCR: {
       auto v = pop_data();
       auto w = pop_data();
       push_data(w->subscr(v));
       break;
     }
+    case BUILD_SLICE: {
+      auto step = op_arg == 3 ? pop_data() : static_value::none_value;
+      auto stop = pop_data();
+      auto start = pop_data();
+      push_data(std::make_shared<slice>(start, stop, step));
+      break;
+    }
     case STORE_MAP: {
       auto k = pop_data();
       auto v = pop_data();
@@ -238,6 +387,16 @@ void interpreter::eval_frame() {
 
     case UNPACK_SEQUENCE: {
       auto v = pop_data();
+      if (v->get_klass() == tuple_klass::get_instance()) {
+        // multiple returns unpack straight from the items
+        auto tpl = std::static_pointer_cast<tuple>(v);
+        assert(tpl->size() == static_cast<size_t>(op_arg) &&
+               "ValueError: wrong number of values to unpack");
+        while (op_arg--) {
+          push_data(tpl->at(op_arg));
+        }
+        break;
+      }
       while (op_arg--) {
         push_data(v->subscr(std::make_shared<integer>(op_arg)));
       }
@@ -245,14 +404,35 @@ void interpreter::eval_frame() {
     }
     case FOR_ITER: {
       auto v = top_data();
-      auto w = v->next();
+      std::shared_ptr<object> w;
+
+      // range iterators step an unboxed counter in place, no dispatch through
+      // klass::next is needed
+      if (v->get_klass() == range_iterator_klass::get_instance()) {
+        auto range_iter = static_cast<range_iterator *>(v.get());
+        if (!range_iter->exhausted()) {
+          w = std::make_shared<integer>(range_iter->advance());
+        }
+      } else if (v->get_klass() == generator_klass::get_instance()) {
+        // a generator runs on in this loop, its yield pushes the next item
+        auto &g = static_cast<Generator &>(*v);
+        if (g.get_frame()) {
+          resume_inline(g, static_value::none_value);
+          break;
+        }
+      } else {
+        w = v->next();
+      }
 
       if (w == nullptr) {
-        // assert(cur_status == status::is_exception &&
-        //        pending_exception == static_value::stop_iteration);
+        if (cur_status == status::is_exception &&
+            exception_class != static_value::stop_iteration) {
+          // raised by next(), unwound below
+          break;
+        }
+        clear_exception();
+        pop_data();
         cur_frame->set_pc(cur_frame->get_pc() + op_arg);
-        cur_status = status::is_ok;
-        pending_exception = nullptr;
       } else {
         push_data(w);
       }
@@ -279,19 +459,57 @@ void interpreter::eval_frame() {
       break;
     }
     case YIELD_VALUE:
-      // we are assured that we're in the progress
-      // of evalating generator.
-      cur_status = status::is_yield;
-      ret_value = top_data();
-      return;
+      if (yield_value(pop_data())) {
+        return;
+      }
+      break;
 
-    case POP_BLOCK:
-      while (!cur_frame->get_data_stack().empty() &&
-             cur_frame->get_data_stack().size() >
-                 cur_frame->get_loop_stack().top().level) {
-        cur_frame->get_data_stack().pop();
+    case GET_YIELD_FROM_ITER:
+      // a generator is delegated to as it is
+      if (top_data()->get_klass() != generator_klass::get_instance()) {
+        push_data(pop_data()->iter());
+      }
+      break;
+
+    case YIELD_FROM: {
+      auto v = pop_data();
+      auto receiver = top_data();
+      if (receiver->get_klass() == generator_klass::get_instance()) {
+        auto &g = static_cast<Generator &>(*receiver);
+        if (g.get_frame()) {
+          resume_inline(g, std::move(v));
+          break;
+        }
+        pop_data();
+        push_data(static_value::none_value);
+        break;
+      }
+
+      assert(v == static_value::none_value &&
+             "AttributeError: object has no attribute 'send'");
+      auto w = receiver->next();
+      if (w == nullptr) {
+        if (cur_status == status::is_exception &&
+            exception_class != static_value::stop_iteration) {
+          break;
+        }
+        clear_exception();
+        pop_data();
+        push_data(static_value::none_value);
+        break;
       }
-      cur_frame->get_loop_stack().pop();
+      // the value sent back runs this YIELD_FROM again
+      cur_frame->rewind();
+      if (yield_value(std::move(w))) {
+        return;
+      }
+      break;
+    }
+
+    // try blocks are looked up in the handler table of the code when an
+    // exception is raised, entering and leaving them costs nothing
+    case SETUP_FINALLY:
+    case POP_BLOCK:
       break;
 
     case STORE_NAME: {
@@ -300,14 +518,20 @@ void interpreter::eval_frame() {
       break;
     }
     case POP_EXCEPT:
-      // while (!cur_frame->get_data_stack()->empty() &&
-      //        cur_frame->get_data_stack()->size() >
-      //            cur_frame->get_loop_stack().top().level) {
-      //   pop_data();
-      // }
-      // cur_frame->get_loop_stack().pop();
       break;
 
+    case RERAISE: {
+      // exception class, value and traceback pushed when the handler began
+      auto exc = pop_data();
+      auto val = pop_data();
+      auto tb = pop_data();
+      if (tb == static_value::none_value) {
+        tb = nullptr;
+      }
+      do_raise(exc, val, tb);
+      break;
+    }
+
     case DELETE_NAME: {
       auto v = cur_frame->get_names()->at(op_arg);
       cur_frame->get_locals()->remove(v);
@@ -346,13 +570,11 @@ void interpreter::eval_frame() {
       break;
     }
     case BUILD_TUPLE: {
-      std::vector<std::shared_ptr<object>> tmp;
-      tmp.resize(op_arg);
-
+      auto tpl = tuple::create(op_arg);
       while (op_arg--) {
-        tmp.at(op_arg) = pop_data();
+        tpl->set(op_arg, pop_data());
       }
-      push_data(std::make_shared<tuple>(std::move(tmp)));
+      push_data(tpl);
       break;
     }
     case BUILD_LIST: {
@@ -365,8 +587,30 @@ void interpreter::eval_frame() {
       push_data(lst);
       break;
     }
+    case BUILD_SET: {
+      auto set_obj = std::make_shared<set>();
+      set_obj->reserve(op_arg);
+
+      auto &stack = cur_frame->get_data_stack();
+      for (auto i = stack.end() - op_arg; i != stack.end(); ++i) {
+        set_obj->add(*i);
+      }
+      stack.resize(stack.size() - op_arg);
+      push_data(set_obj);
+      break;
+    }
     case BUILD_MAP: {
       auto v = std::make_shared<dict>();
+
+      // op_arg key and value pairs, the first pair deepest
+      auto &stack = cur_frame->get_data_stack();
+      for (auto i = stack.end() - 2 * op_arg; i != stack.end(); i += 2) {
+        if (!dict::check_key(*i)) {
+          break;
+        }
+        v->insert(*i, *(i + 1));
+      }
+      stack.resize(stack.size() - 2 * op_arg);
       push_data(v);
       break;
     }
@@ -463,24 +707,29 @@ void interpreter::eval_frame() {
     case CONTAINS_OP: {
       auto lst = pop_data();
       auto value = pop_data();
-      push_data(lst->contains(value));
+      auto r = lst->contains(value);
+      // op_arg 1 is `not in`
+      if (op_arg == 1) {
+        r = static_value::get_bool_value(r == static_value::false_value);
+      }
+      push_data(r);
       break;
     }
 
     case JUMP_IF_NOT_EXC_MATCH: {
-      auto u = pop_data(); // TOS
-      auto v = pop_data(); // the second value
+      auto u = pop_data(); // the type or tuple of types to catch
+      auto v = pop_data(); // the class of the exception
 
+      auto mro = std::static_pointer_cast<type>(v)->get_own_klass()->get_mro();
+      auto matches = [&v, &mro](const std::shared_ptr<object> &t) {
+        return v == t || mro->has_pointer(t);
+      };
       bool match = false;
-      auto mro_lst = std::static_pointer_cast<type>(v)
-                         ->get_own_klass()
-                         ->get_mro()
-                         ->get_value();
-
-      if (v == u) {
-        match = true;
+      if (u->get_klass() == tuple_klass::get_instance()) {
+        match = std::ranges::any_of(
+            std::static_pointer_cast<tuple>(u)->get_value(), matches);
       } else {
-        match = std::find(mro_lst.begin(), mro_lst.end(), u) != mro_lst.end();
+        match = matches(u);
       }
 
       if (!match) {
@@ -490,17 +739,16 @@ void interpreter::eval_frame() {
       break;
     }
 
-    case SETUP_FINALLY:
-      cur_frame->get_loop_stack().push({op_code, cur_frame->get_pc() + op_arg,
-                                        cur_frame->get_data_stack().size()});
-      break;
-
-    case LOAD_FAST:
-      push_data(cur_frame->get_fast_locals()->at(op_arg));
+    case LOAD_FAST: {
+      auto &v = cur_frame->get_fast_locals()[op_arg];
+      assert(v && "UnboundLocalError: local variable referenced before "
+                  "assignment");
+      push_data(v);
       break;
+    }
 
     case STORE_FAST:
-      cur_frame->get_fast_locals()->set_at(op_arg, pop_data());
+      cur_frame->get_fast_locals()[op_arg] = pop_data();
       break;
     case RAISE_VARARGS: {
       switch (op_arg) {
@@ -531,6 +779,17 @@ void interpreter::eval_frame() {
       break;
     }
     case CALL_FUNCTION: {
+      auto &stack = cur_frame->get_data_stack();
+      if (auto &callable = stack[stack.size() - op_arg - 1];
+          is_vectorcall(callable)) {
+        // the arguments are read where they lie on the value stack
+        auto result = std::static_pointer_cast<function>(callable)->vectorcall(
+            vector_args_t{stack}.last(op_arg));
+        stack.resize(stack.size() - op_arg - 1);
+        push_data(result);
+        break;
+      }
+
       std::shared_ptr<std::vector<std::shared_ptr<object>>> args;
       if (op_arg > 0) {
         args = std::make_shared<std::vector<std::shared_ptr<object>>>();
@@ -560,9 +819,7 @@ void interpreter::eval_frame() {
         auto free_args = pop_data();
         assert(free_args &&
                free_args->get_klass() == tuple_klass::get_instance());
-        auto tpl_def_args = std::static_pointer_cast<tuple>(free_args);
-        auto args = std::make_shared<list>(tpl_def_args->get_value());
-        func->set_closure(args);
+        func->set_closure(std::static_pointer_cast<tuple>(free_args));
       }
       if (op_arg & 0x04) {
         // a tuple of strings containing parameters' annotations
@@ -579,8 +836,9 @@ void interpreter::eval_frame() {
         assert(def_args &&
                def_args->get_klass() == tuple_klass::get_instance());
         auto tpl_def_args = std::static_pointer_cast<tuple>(def_args);
+        auto defaults = tpl_def_args->get_value();
         auto args = std::make_shared<std::vector<std::shared_ptr<object>>>(
-            tpl_def_args->get_value());
+            defaults.begin(), defaults.end());
         func->set_default_args(args);
       }
 
@@ -588,31 +846,19 @@ void interpreter::eval_frame() {
       break;
     }
 
-    case LOAD_CLOSURE: {
-      auto v = cur_frame->get_closure()->at(op_arg);
-      if (!v) {
-        v = cur_frame->get_cell_from_parameter(op_arg);
-        cur_frame->get_closure()->set(op_arg, v);
-      }
-      if (v->get_klass() == cell_klass::get_instance()) {
-        push_data(v);
-      } else {
-        push_data(std::make_shared<cell>(cur_frame->get_closure(), op_arg));
-      }
+    case LOAD_CLOSURE:
+      push_data(cur_frame->get_cell(op_arg));
       break;
-    }
 
     case LOAD_DEREF: {
-      auto v = cur_frame->get_closure()->at(op_arg);
-      if (v->get_klass() == cell_klass::get_instance()) {
-        v = (std::static_pointer_cast<cell>(v))->value();
-      }
+      auto &v = static_cast<cell &>(*cur_frame->get_cell(op_arg)).get();
+      assert(v && "NameError: free variable referenced before assignment");
       push_data(v);
       break;
     }
 
     case STORE_DEREF:
-      cur_frame->get_closure()->set(op_arg, pop_data());
+      static_cast<cell &>(*cur_frame->get_cell(op_arg)).set(pop_data());
       break;
 
     case CALL_FUNCTION_KW: {
@@ -624,6 +870,7 @@ void interpreter::eval_frame() {
         const int kw_size = static_cast<int>(tpl_obj->size());
         int i{kw_size};
         auto kwargs = std::make_shared<dict>();
+        kwargs->set_keyword_args(true);
         while (i--) {
           kwargs->insert(tpl_obj->at(i), pop_data());
         }
@@ -644,6 +891,55 @@ void interpreter::eval_frame() {
       break;
     }
 
+    case FORMAT_VALUE: {
+      std::shared_ptr<object> spec;
+      if (op_arg & 0x04) {
+        spec = pop_data();
+        assert(spec->get_klass() == string_klass::get_instance());
+      }
+      auto v = pop_data();
+
+      constexpr std::array conversions{'\0', 's', 'r', 'a'};
+      auto conversion = conversions[op_arg & 0x03];
+
+      // a plain string is its own formatted value
+      if (v->get_klass() == string_klass::get_instance() && !spec &&
+          (conversion == '\0' || conversion == 's')) {
+        push_data(v);
+        break;
+      }
+
+      std::string result;
+      if (!format_value_to(
+              result, v, conversion,
+              spec ? std::static_pointer_cast<string>(spec)->get_value()
+                   : "")) {
+        break;
+      }
+      push_data(std::make_shared<string>(std::move(result)));
+      break;
+    }
+
+    case BUILD_STRING: {
+      auto &stack = cur_frame->get_data_stack();
+      auto first = stack.end() - op_arg;
+
+      size_t total = 0;
+      for (auto i = first; i != stack.end(); ++i) {
+        assert((*i)->get_klass() == string_klass::get_instance());
+        total += static_cast<string *>(i->get())->size();
+      }
+
+      std::string result;
+      result.reserve(total);
+      for (auto i = first; i != stack.end(); ++i) {
+        result += static_cast<string *>(i->get())->get_value();
+      }
+      stack.resize(stack.size() - op_arg);
+      push_data(std::make_shared<string>(std::move(result)));
+      break;
+    }
+
     case BUILD_CONST_KEY_MAP: {
       auto keys = pop_data();
       assert(keys && keys->get_klass() == tuple_klass::get_instance());
@@ -659,25 +955,47 @@ void interpreter::eval_frame() {
     }
 
     case LOAD_METHOD: {
+      // pushes [function, owner] for a native method of an object without
+      // its own attributes, so no bound method is created, and
+      // [nullptr, attribute] otherwise
       auto v = pop_data();
-      auto w = cur_frame->get_names()->at(op_arg); // owner
+      auto w = cur_frame->get_names()->at(op_arg);
+      if (!v->get_obj_dict()) {
+        auto attr = v->get_klass()->find_in_parents(v, w);
+        if (attr->get_klass() == native_function_klass::get_instance()) {
+          push_data(attr);
+          push_data(v);
+          break;
+        }
+      }
+      push_data(nullptr);
       push_data(v->getattr(w));
       break;
     }
 
     case CALL_METHOD: {
+      auto &stack = cur_frame->get_data_stack();
+      auto base = stack.size() - op_arg - 2;
+      bool unbound = stack[base] != nullptr;
+      auto callable = unbound ? stack[base] : stack[base + 1];
+      int arg_cnt = unbound ? op_arg + 1 : op_arg;
+
+      if (is_vectorcall(callable)) {
+        auto result = std::static_pointer_cast<function>(callable)->vectorcall(
+            vector_args_t{stack}.last(arg_cnt));
+        stack.resize(base);
+        push_data(result);
+        break;
+      }
+
       std::shared_ptr<std::vector<std::shared_ptr<object>>> args;
-      if (op_arg > 0) {
-        args = std::make_shared<std::vector<std::shared_ptr<object>>>();
-        args->resize(op_arg);
-        int i{op_arg};
-        while (i--) {
-          args->at(i) = pop_data();
-        }
+      if (arg_cnt > 0) {
+        args = std::make_shared<std::vector<std::shared_ptr<object>>>(
+            stack.end() - arg_cnt, stack.end());
       }
-      auto func = pop_data();
+      stack.resize(base);
 
-      build_frame(func, args, op_arg);
+      build_frame(callable, args, arg_cnt);
       break;
     }
 
@@ -696,59 +1014,88 @@ void interpreter::eval_frame() {
       push_data(lst);
       break;
     }
-    default:
-      std::println("Error: Unrecognized byte code {:#04x}", op_code);
-    }
-
-    while (cur_status != status::is_ok &&
-           cur_frame->get_loop_stack().size() != 0) {
 
-      auto b = cur_frame->get_loop_stack().top();
-      cur_frame->get_loop_stack().pop();
+    case LIST_APPEND: {
+      auto v = pop_data();
+      auto l = peek_data(op_arg);
+      assert(l && l->get_klass() == list_klass::get_instance());
+      std::static_pointer_cast<list>(l)->append(v);
+      break;
+    }
 
-      while (cur_frame->get_data_stack().size() > b.level) {
-        pop_data();
+    case MAP_ADD: {
+      auto v = pop_data();
+      auto k = pop_data();
+      auto m = peek_data(op_arg);
+      assert(m && m->get_klass() == dict_klass::get_instance());
+      if (dict::check_key(k)) {
+        std::static_pointer_cast<dict>(m)->insert(k, v);
       }
+      break;
+    }
 
-      if (b.type == std::to_underlying(bytecode::SETUP_FINALLY) ||
-          cur_status == status::is_exception) {
-        if (cur_status == status::is_exception) {
-          // traceback, value, exception class
-          push_data(trace_back);
-          push_data(pending_exception);
-          push_data(exception_class);
+    case SET_ADD: {
+      auto v = pop_data();
+      auto s = peek_data(op_arg);
+      assert(s && s->get_klass() == set_klass::get_instance());
+      std::static_pointer_cast<set>(s)->add(v);
+      break;
+    }
 
-          trace_back = nullptr;
-          pending_exception = nullptr;
-          exception_class = nullptr;
+    case SET_UPDATE: {
+      auto v = pop_data();
+      auto s = peek_data(op_arg);
+      assert(s && s->get_klass() == set_klass::get_instance());
+      std::static_pointer_cast<set>(s)->update(v);
+      break;
+    }
+    default:
+      std::println("Error: Unrecognized byte code {:#04x}", op_code);
+    }
 
-        } else {
-          if (cur_status == status::is_return) {
-            push_data(ret_value);
-          }
-        }
-        cur_frame->set_pc(b.target);
-        cur_status = status::is_ok;
-      }
+    if (cur_status != status::is_ok && unwind()) {
+      return;
     }
-    // has pending exception and no handler found, unwind stack.
-    if (cur_status != status::is_ok &&
-        cur_frame->get_loop_stack().size() == 0) {
-      if (cur_status == status::is_exception) {
-        ret_value = nullptr;
-        std::static_pointer_cast<traceback>(trace_back)
-            ->record_frame(cur_frame);
-      }
-      if (cur_status == status::is_return) {
+  }
+}
+
+bool interpreter::unwind() {
+  while (cur_status != status::is_ok) {
+    if (cur_status == status::is_exception) {
+      if (auto h = cur_frame->find_handler(); h) {
+        // values pushed inside the try block are dropped, then traceback,
+        // value and exception class are pushed for the handler
+        cur_frame->get_data_stack().resize(h->depth);
+        push_data(trace_back ? trace_back : static_value::none_value);
+        push_data(pending_exception);
+        push_data(exception_class);
+
+        trace_back = nullptr;
+        pending_exception = nullptr;
+        exception_class = nullptr;
+
+        cur_frame->set_pc(h->target);
         cur_status = status::is_ok;
+        break;
       }
 
-      if (cur_frame->is_first_frame() || cur_frame->is_entry_frame()) {
-        return;
+      // has pending exception and no handler found, unwind stack.
+      ret_value = nullptr;
+      if (!trace_back) {
+        // only built once the exception leaves a frame uncaught
+        trace_back = std::make_shared<traceback>();
       }
-      leave_frame();
+      std::static_pointer_cast<traceback>(trace_back)->record_frame(cur_frame);
+    } else if (cur_status == status::is_return) {
+      cur_status = status::is_ok;
     }
+
+    if (cur_frame->is_first_frame() || cur_frame->is_entry_frame()) {
+      return true;
+    }
+    leave_frame();
   }
+  return false;
 }
 
 void interpreter::build_frame(
@@ -798,8 +1145,9 @@ void interpreter::build_frame(
     if (m != static_value::none_value) {
       build_frame(m, args, real_arg_cnt, has_kw_arg);
     } else {
-      std::println("Error : can not call a normal object <{}>.",
-                   callable->str()->get_value());
+      raise_error(exception_klass::type_error,
+                  std::format("'{}' object is not callable",
+                              callable->get_klass()->get_name()));
     }
   }
 }
@@ -812,10 +1160,37 @@ void interpreter::enter_frame(std::shared_ptr<frame> new_frame) {
 void interpreter::destroy_frame() { cur_frame = cur_frame->get_caller(); }
 
 void interpreter::leave_frame() {
+  if (cur_frame->get_generator()) {
+    finish_inline();
+    return;
+  }
   destroy_frame();
   push_data(ret_value);
 }
 
+void interpreter::suspend_frame() {
+  auto frm = cur_frame;
+  cur_frame = frm->get_caller();
+  // a suspended generator must not keep the frame that resumed it alive
+  frm->set_caller(nullptr);
+}
+
+bool interpreter::clear_stop_iteration() {
+  if (cur_status != status::is_exception ||
+      exception_class != static_value::stop_iteration) {
+    return false;
+  }
+  clear_exception();
+  return true;
+}
+
+void interpreter::clear_exception() {
+  cur_status = status::is_ok;
+  pending_exception = nullptr;
+  exception_class = nullptr;
+  trace_back = nullptr;
+}
+
 std::shared_ptr<object> interpreter::call_virtual(
     std::shared_ptr<object> callable,
     std::shared_ptr<std::vector<std::shared_ptr<object>>> args) {
@@ -852,45 +1227,155 @@ interpreter::status interpreter::do_raise(std::shared_ptr<object> exc,
 
   assert(exc != nullptr);
 
-  if (tb == nullptr) {
-    tb = std::make_shared<traceback>();
-  }
-
-  if (val != nullptr) {
-    exception_class = exc;
-    pending_exception = val;
-    trace_back = tb;
-    cur_status = status::is_exception;
-    return status::is_exception;
+  if (val == nullptr) {
+    if (exc->get_klass() == type_klass::get_instance()) {
+      auto k = std::static_pointer_cast<type>(exc)->get_own_klass();
+      // signals of iteration and generator control carry no arguments, one
+      // instance serves every raise
+      if (k == exception_klass::stop_iteration ||
+          k == exception_klass::generator_exit) {
+        val = static_cast<exception_klass *>(k)->shared_instance();
+      } else {
+        val = call_virtual(exc, nullptr);
+      }
+    } else {
+      val = exc;
+      exc = val->get_klass()->get_type_object();
+    }
   }
+  assert(exception_klass::is_exception(val) &&
+         "TypeError: exceptions must derive from BaseException");
 
-  if (exc->get_klass() == type_klass::get_instance()) {
-    exception_class = exc;
-    pending_exception = call_virtual(exc, nullptr);
-  } else {
-    pending_exception = exc;
-    exception_class = pending_exception->get_klass()->get_type_object();
-  }
+  exception_class = exc;
+  pending_exception = val;
   trace_back = tb;
   cur_status = status::is_exception;
   return status::is_exception;
 }
 
+void interpreter::enter_generator(Generator &g, std::shared_ptr<object> sent,
+                                  bool entry) {
+  auto frm = g.get_frame();
+  assert(!g.is_running() && "ValueError: generator already executing");
+  bool started = frm->get_pc() > 0;
+  assert((started || sent == static_value::none_value) &&
+         "TypeError: can't send non-None value to a just-started generator");
+
+  frm->set_entry_frame(entry);
+  enter_frame(frm);
+  g.set_running(true);
+  // the value of the yield expression the generator is suspended at
+  if (started) {
+    push_data(std::move(sent));
+  }
+}
+
+std::shared_ptr<object> interpreter::leave_generator(Generator &g) {
+  g.set_running(false);
+  suspend_frame();
+  if (cur_status == status::is_yield) {
+    cur_status = status::is_ok;
+    return ret_value;
+  }
+  g.finish();
+  return nullptr;
+}
+
 std::shared_ptr<object>
-interpreter::eval_generator(std::shared_ptr<Generator> g) {
-  enter_frame(g->get_frame());
-  g->get_frame()->set_entry_frame(true);
+interpreter::resume_generator(Generator &g, std::shared_ptr<object> sent) {
+  if (!g.get_frame()) {
+    return nullptr;
+  }
+  enter_generator(g, std::move(sent), true);
   eval_frame();
+  return leave_generator(g);
+}
 
-  if (cur_status != status::is_yield) { // return from generator
-    cur_status = status::is_ok;
-    leave_frame();
-    g->set_frame(nullptr);
+std::shared_ptr<object>
+interpreter::throw_into_generator(Generator &g, std::shared_ptr<object> exc) {
+  if (!g.get_frame()) {
+    raise(exc);
     return nullptr;
   }
+  assert(!g.is_running() && "ValueError: generator already executing");
+  g.get_frame()->set_entry_frame(true);
+  enter_frame(g.get_frame());
+  g.set_running(true);
+  if (auto [op_code, op_arg] = cur_frame->peek_instruction();
+      op_code == std::to_underlying(bytecode::YIELD_FROM)) {
+    // raised by the YIELD_FROM a delegating generator waits at
+    cur_frame->set_pc(cur_frame->get_pc() + 2);
+  }
 
-  cur_status = status::is_ok;
-  cur_frame = cur_frame->get_caller();
+  // nothing runs unless the generator handles exc
+  raise(exc);
+  if (!unwind()) {
+    eval_frame();
+  }
+  return leave_generator(g);
+}
+
+void interpreter::close_generator(Generator &g) {
+  if (!g.get_frame()) {
+    return;
+  }
+  if (g.get_frame()->get_pc() == 0) {
+    g.finish();
+    return;
+  }
+
+  auto result = throw_into_generator(g, static_value::generator_exit);
+  assert(!result && "RuntimeError: generator ignored GeneratorExit");
+  if (cur_status == status::is_exception &&
+      (exception_class == static_value::generator_exit ||
+       exception_class == static_value::stop_iteration)) {
+    clear_exception();
+  }
+}
 
-  return ret_value;
-}
\ No newline at end of file
+void interpreter::resume_inline(Generator &g, std::shared_ptr<object> sent) {
+  cur_frame->rewind();
+  enter_generator(g, std::move(sent), false);
+}
+
+bool interpreter::yield_value(std::shared_ptr<object> v) {
+  // a generator resumed inline hands v to FOR_ITER in the frame below, or
+  // when that frame delegates to it through YIELD_FROM, yields v in turn
+  while (!cur_frame->is_entry_frame()) {
+    cur_frame->get_generator()->set_running(false);
+    suspend_frame();
+
+    auto [op_code, op_arg] = cur_frame->peek_instruction();
+    if (op_code != std::to_underlying(bytecode::YIELD_FROM)) {
+      cur_frame->set_pc(cur_frame->get_pc() + 2);
+      push_data(std::move(v));
+      return false;
+    }
+  }
+
+  ret_value = std::move(v);
+  cur_status = status::is_yield;
+  return true;
+}
+
+void interpreter::finish_inline() {
+  auto g = cur_frame->get_generator();
+  suspend_frame();
+  g->finish();
+  auto [op_code, op_arg] = cur_frame->peek_instruction();
+  auto pc = cur_frame->get_pc() + 2;
+  if (cur_status == status::is_exception) {
+    // unwound from the FOR_ITER or YIELD_FROM that resumed the generator
+    cur_frame->set_pc(pc);
+    return;
+  }
+
+  // pops the generator, the value of yield from is its return value
+  pop_data();
+  if (op_code == std::to_underlying(bytecode::FOR_ITER)) {
+    cur_frame->set_pc(pc + op_arg);
+  } else {
+    push_data(ret_value);
+    cur_frame->set_pc(pc);
+  }
+}
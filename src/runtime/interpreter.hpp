@@ -27,19 +27,52 @@ public:
                std::shared_ptr<std::vector<std::shared_ptr<object>>> args);
   std::shared_ptr<dict> run_module(std::shared_ptr<code_object> codes,
                                    std::shared_ptr<string> module_name);
-  std::shared_ptr<object> eval_generator(std::shared_ptr<Generator> g);
+
+  /// @brief runs g until it yields, sent is the value of the yield it is
+  /// suspended at. nullptr once g has returned, or raised with the exception
+  /// left pending.
+  std::shared_ptr<object> resume_generator(Generator &g,
+                                           std::shared_ptr<object> sent);
+  /// @brief raises exc at the yield g is suspended at
+  std::shared_ptr<object> throw_into_generator(Generator &g,
+                                               std::shared_ptr<object> exc);
+  /// @brief raises GeneratorExit in g if it is suspended
+  void close_generator(Generator &g);
+
+  /// @brief raises exc, an exception type or instance, from native code
+  void raise(std::shared_ptr<object> exc) { do_raise(exc, nullptr, nullptr); }
+  bool has_pending_exception() const {
+    return cur_status == status::is_exception;
+  }
+  /// @brief clears a pending StopIteration, true if there was one
+  bool clear_stop_iteration();
+
+  /// @brief the running frame without taking a reference, for the profiler
+  frame *running_frame() const { return cur_frame.get(); }
+
+  /// @brief locals() of the running frame
+  std::shared_ptr<dict> current_locals() { return cur_frame->locals_view(); }
 
 private:
-  auto top_data() { return cur_frame->get_data_stack().top(); }
+  auto top_data() { return cur_frame->get_data_stack().back(); }
+  /// @brief the n-th item from the top, peek_data(1) is top_data()
+  auto peek_data(int n) {
+    auto &stack = cur_frame->get_data_stack();
+    return stack[stack.size() - n];
+  }
   void push_data(const std::shared_ptr<object> &v) {
-    cur_frame->get_data_stack().push(v);
+    cur_frame->get_data_stack().push_back(v);
   }
   std::shared_ptr<object> pop_data() {
-    auto r = cur_frame->get_data_stack().top();
-    cur_frame->get_data_stack().pop();
+    auto r = std::move(cur_frame->get_data_stack().back());
+    cur_frame->get_data_stack().pop_back();
     return r;
   }
 
+  /// @brief true when the only reference to w besides the caller's is the
+  /// variable the next instruction stores into, so w can be mutated in place
+  bool is_owned_by_next_store(const std::shared_ptr<object> &w);
+
   void build_frame(std::shared_ptr<object> callable,
                    std::shared_ptr<std::vector<std::shared_ptr<object>>> args,
                    int real_arg_cnt = 0, bool has_kw_arg = false);
@@ -47,6 +80,25 @@ private:
   void eval_frame();
   void destroy_frame();
   void leave_frame();
+  /// @brief unwinds blocks, then frames, while an exception or a return is
+  /// pending. true when eval_frame has to return.
+  bool unwind();
+
+  /// @brief unlinks the running frame from its caller, which runs again
+  void suspend_frame();
+  void enter_generator(Generator &g, std::shared_ptr<object> sent,
+                       bool entry);
+  std::shared_ptr<object> leave_generator(Generator &g);
+  /// @brief runs g inside eval_frame. The running frame executes the
+  /// current FOR_ITER or YIELD_FROM again once g yields or returns.
+  void resume_inline(Generator &g, std::shared_ptr<object> sent);
+  /// @brief the running generator yields v. true when v leaves eval_frame
+  /// through an entry frame.
+  bool yield_value(std::shared_ptr<object> v);
+  /// @brief the running generator resumed inline has returned or raised
+  void finish_inline();
+  /// @brief clears a pending exception
+  void clear_exception();
 
   status do_raise(std::shared_ptr<object> exc, std::shared_ptr<object> val,
                   std::shared_ptr<object> tb);
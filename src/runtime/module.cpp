@@ -2,6 +2,7 @@
 #include "code/pyc_parser.hpp"
 #include "inc/cppython.hpp"
 #include "object/dict.hpp"
+#include "object/mmap.hpp"
 #include "object/string.hpp"
 #include "runtime/interpreter.hpp"
 #include "runtime/string_table.hpp"
@@ -9,11 +10,19 @@
 #include <cassert>
 #include <filesystem>
 #include <print>
+#include <string_view>
+#include <unordered_map>
 
 #include <windows.h>
 
 using namespace cppython;
 
+// extension modules linked into the interpreter itself. A library in lib/
+// carries its own copy of every klass singleton, so a module that defines a
+// new type has to live here for the type to be shared with the interpreter.
+static const std::unordered_map<std::string_view, init_func *>
+    native_modules{{"mmap", init_libmmap}};
+
 void module_klass::initialize() {
   set_dict(std::make_shared<dict>());
   set_name("module");
@@ -27,6 +36,11 @@ Module::Module(std::shared_ptr<dict> x) {
 }
 
 std::shared_ptr<Module> Module::import(std::shared_ptr<string> module_name) {
+  if (auto it = native_modules.find(module_name->get_value());
+      it != native_modules.end()) {
+    return from_methods(it->second());
+  }
+
   auto file_name = std::format(R"(./lib/{}.dll)", module_name->get_value());
 
   if (std::filesystem::exists(file_name)) {
@@ -61,14 +75,19 @@ Module::import_dll(std::shared_ptr<string> module_name) {
   auto module_init_func = reinterpret_cast<init_func *>(
       ::GetProcAddress(hdll, init_method.c_str()));
 
-  auto method_list = module_init_func();
+  return from_methods(module_init_func());
+}
 
+std::shared_ptr<Module> Module::from_methods(const ext_method *methods) {
   auto mod = std::make_shared<Module>(std::make_shared<dict>());
 
-  while (method_list->method_func != nullptr) {
-    mod->insert(std::make_shared<string>(method_list->method_name),
-                std::make_shared<function>(method_list->method_func));
-    method_list++;
+  while (methods->method_func != nullptr ||
+         methods->method_vector_func != nullptr) {
+    auto func = methods->method_vector_func != nullptr
+                    ? std::make_shared<function>(methods->method_vector_func)
+                    : std::make_shared<function>(methods->method_func);
+    mod->insert(std::make_shared<string>(methods->method_name), func);
+    methods++;
   }
   return mod;
 }
@@ -9,6 +9,7 @@
 namespace cppython {
 
 class dict;
+struct ext_method;
 
 class module_klass : public klass, public singleton<module_klass> {
   friend class singleton<module_klass>;
@@ -24,6 +25,8 @@ public:
   static std::shared_ptr<Module> import(std::shared_ptr<string> module_name);
   static std::shared_ptr<Module>
   import_dll(std::shared_ptr<string> module_name);
+  /// @brief a module of the native functions in methods
+  static std::shared_ptr<Module> from_methods(const ext_method *methods);
 
   void extend(std::shared_ptr<Module> m);
 
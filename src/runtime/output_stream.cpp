@@ -0,0 +1,101 @@
+#include "runtime/output_stream.hpp"
+
+#include <array>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+using namespace cppython;
+
+output_stream::output_stream(std::FILE *file, size_t capacity)
+    : file{file}, buffer(capacity) {
+  line_buffered = isatty(fileno(file));
+}
+
+void output_stream::write(std::string_view s) {
+  if (s.size() > buffer.size() - used) {
+    flush();
+    // too large to be worth copying
+    if (s.size() >= buffer.size()) {
+      std::fwrite(s.data(), 1, s.size(), file);
+      std::fflush(file);
+      return;
+    }
+  }
+
+  std::memcpy(buffer.data() + used, s.data(), s.size());
+  used += s.size();
+  if (line_buffered && s.find('\n') != std::string_view::npos) {
+    flush();
+  }
+}
+
+void output_stream::write_int(long long v) {
+  std::array<char, 24> digits;
+  auto r = std::to_chars(digits.data(), digits.data() + digits.size(), v);
+  write(std::string_view{digits.data(), r.ptr});
+}
+
+void output_stream::write_double(double v) {
+  // float's str() is std::to_string, which is fixed with 6 decimals
+  std::array<char, 400> digits;
+  auto r = std::to_chars(digits.data(), digits.data() + digits.size(), v,
+                         std::chars_format::fixed, 6);
+  write(std::string_view{digits.data(), r.ptr});
+}
+
+void output_stream::flush() {
+  if (used > 0) {
+    std::fwrite(buffer.data(), 1, used, file);
+    used = 0;
+  }
+  std::fflush(file);
+}
+
+static long long write_fd(int fd, const char *p, size_t n) {
+#ifdef _WIN32
+  return _write(fd, p, static_cast<unsigned>(n));
+#else
+  return ::write(fd, p, n);
+#endif
+}
+
+void output_stream::flush_raw() noexcept {
+  const char *p = buffer.data();
+  while (used > 0) {
+    auto n = write_fd(fileno(file), p, used);
+    if (n <= 0) {
+      break;
+    }
+    p += n;
+    used -= static_cast<size_t>(n);
+  }
+}
+
+// the stream an abort flushes, set once standard_output() exists
+static output_stream *abort_stream = nullptr;
+
+static void flush_on_abort(int sig) {
+  // a failed assert aborts without running the static destructor, so the
+  // buffered output would be lost
+  abort_stream->flush_raw();
+  std::signal(sig, SIG_DFL);
+  std::raise(sig);
+}
+
+output_stream &output_stream::standard_output() {
+  static output_stream out{stdout};
+  if (abort_stream == nullptr) {
+    abort_stream = &out;
+    std::signal(SIGABRT, flush_on_abort);
+  }
+  return out;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace cppython {
+
+/// @brief userspace buffered writer over a FILE*. print formats straight into
+/// the buffer, which reaches the file in large chunks: when full, on flush,
+/// at a newline for terminals, at exit, and on abort for stdout.
+class output_stream {
+public:
+  explicit output_stream(std::FILE *file, size_t capacity = 64 * 1024);
+  ~output_stream() { flush(); }
+
+  output_stream(const output_stream &) = delete;
+  output_stream &operator=(const output_stream &) = delete;
+
+  void write(std::string_view s);
+  void write(char c) {
+    if (used == buffer.size()) {
+      flush();
+    }
+    buffer[used++] = c;
+    if (c == '\n' && line_buffered) {
+      flush();
+    }
+  }
+  void write_int(long long v);
+  /// @brief formats v the same way as float's str()
+  void write_double(double v);
+
+  void flush();
+  /// @brief writes the buffer with the raw write call, without stdio, so
+  /// that a signal handler can call it
+  void flush_raw() noexcept;
+
+  /// @brief the process wide stdout stream, flushed on SIGABRT as well
+  static output_stream &standard_output();
+
+private:
+  std::FILE *file;
+  std::vector<char> buffer;
+  size_t used{0};
+  bool line_buffered{false};
+};
+
+} // namespace cppython
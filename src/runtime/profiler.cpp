@@ -0,0 +1,181 @@
+#include "runtime/profiler.hpp"
+#include "code/code_object.hpp"
+#include "object/string.hpp"
+#include "runtime/interpreter.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <format>
+#include <map>
+#include <print>
+#include <ranges>
+#include <string_view>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+using namespace cppython;
+
+#ifdef _WIN32
+bool profiler::start(std::string path, int interval_us) { return false; }
+
+void profiler::stop() {}
+#else
+bool profiler::start(std::string path, int interval_us) {
+  this->path = std::move(path);
+  frames.resize(capacity);
+  used = 0;
+  dropped = 0;
+
+  struct sigaction action {};
+  action.sa_handler = on_signal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (::sigaction(SIGPROF, &action, nullptr) != 0) {
+    return false;
+  }
+
+  running = true;
+  itimerval timer{.it_interval = {.tv_sec = 0, .tv_usec = interval_us},
+                  .it_value = {.tv_sec = 0, .tv_usec = interval_us}};
+  if (::setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    running = false;
+    ::signal(SIGPROF, SIG_DFL);
+    return false;
+  }
+  return true;
+}
+
+void profiler::stop() {
+  if (!running) {
+    return;
+  }
+  // a signal still pending after the timer stops must not end the program
+  running = false;
+  itimerval timer{};
+  ::setitimer(ITIMER_PROF, &timer, nullptr);
+  ::signal(SIGPROF, SIG_IGN);
+
+  write_profile();
+}
+#endif
+
+void profiler::keep(std::shared_ptr<code_object> code) {
+  if (running) {
+    roots.push_back(std::move(code));
+  }
+}
+
+void profiler::on_signal(int) { get_instance()->sample(); }
+
+void profiler::sample() {
+  if (!running) {
+    return;
+  }
+  // the handler interrupts the interpreter thread itself, the frames it
+  // reaches stay alive until it returns. No reference counts are touched.
+  auto frm = interpreter::get_instance()->running_frame();
+  if (frm == nullptr) {
+    return;
+  }
+  if (capacity - used <= max_depth) {
+    dropped = dropped + 1;
+    return;
+  }
+
+  size_t n = used;
+  for (size_t depth = 0; frm != nullptr && depth < max_depth; depth++) {
+    frames[n++] = {frm->get_code().get(), frm->instruction_offset()};
+    frm = frm->get_caller_frame();
+  }
+  frames[n++] = {nullptr, 0};
+  used = n;
+}
+
+static std::string_view name_of(const std::shared_ptr<object> &x) {
+  return std::static_pointer_cast<string>(x)->get_value();
+}
+
+/// @brief the samples of the keys with the most, most first
+static void print_top(std::string_view title,
+                      const std::map<std::string, size_t> &counts,
+                      size_t sample_cnt) {
+  std::vector<std::pair<size_t, std::string_view>> top;
+  for (auto &[key, count] : counts) {
+    top.emplace_back(count, key);
+  }
+  auto n = std::min<size_t>(top.size(), 10);
+  std::ranges::partial_sort(top, top.begin() + n, std::greater{});
+
+  std::println(stderr, "{}:", title);
+  for (auto &[count, key] : top | std::views::take(n)) {
+    std::println(stderr, "{:>8} {:5.1f}%  {}", count,
+                 100.0 * count / sample_cnt, key);
+  }
+}
+
+void profiler::write_profile() {
+  // a stack is written as "outermost;...;innermost count", each frame named
+  // "function (file:line)" like py-spy does
+  std::map<std::string, size_t> stacks;
+  // the samples spent in a function or a line itself
+  std::map<std::string, size_t> function_counts;
+  std::map<std::string, size_t> line_counts;
+  size_t sample_cnt = 0;
+
+  std::vector<std::string> labels;
+  for (size_t i = 0, first = 0; i < used; i++) {
+    auto [code, offset] = frames[i];
+    if (code != nullptr) {
+      labels.push_back(std::format("{} ({}:{})", name_of(code->name),
+                                   name_of(code->filename),
+                                   code->line_of(offset)));
+      continue;
+    }
+
+    auto leaf = frames[first].code;
+    first = i + 1;
+    if (labels.empty()) {
+      continue;
+    }
+    sample_cnt++;
+    function_counts[std::format("{} ({})", name_of(leaf->name),
+                                name_of(leaf->filename))]++;
+    line_counts[labels.front()]++;
+
+    std::string stack;
+    for (auto &label : labels | std::views::reverse) {
+      if (!stack.empty()) {
+        stack += ';';
+      }
+      stack += label;
+    }
+    stacks[stack]++;
+    labels.clear();
+  }
+
+  if (auto file = std::fopen(path.c_str(), "w"); file != nullptr) {
+    for (auto &[stack, count] : stacks) {
+      std::println(file, "{} {}", stack, count);
+    }
+    std::fclose(file);
+    std::println(stderr, "profile: {} samples written to {}", sample_cnt,
+                 path);
+  } else {
+    std::println(stderr, "profile: cannot write {}", path);
+  }
+  if (dropped > 0) {
+    std::println(stderr, "profile: {} samples dropped, the buffer was full",
+                 size_t{dropped});
+  }
+  if (sample_cnt > 0) {
+    print_top("functions", function_counts, sample_cnt);
+    print_top("lines", line_counts, sample_cnt);
+  }
+
+  frames.clear();
+  frames.shrink_to_fit();
+  roots.clear();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "utils/singleton.hpp"
+
+#include <csignal>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cppython {
+
+class code_object;
+
+/// @brief a sampling profiler. A profiling timer interrupts the program,
+/// and the signal handler copies the (code, offset) chain of the running
+/// frames into a buffer reserved up front. The stacks are only named and
+/// counted when the profile is written, in the collapsed format of
+/// flamegraph tools. Nothing is installed unless start() is called.
+class profiler : public singleton<profiler> {
+  friend class singleton<profiler>;
+
+public:
+  /// @brief samples every interval_us of CPU time until stop(). false when
+  /// the platform has no profiling timer.
+  bool start(std::string path, int interval_us = 1000);
+  /// @brief stops sampling and writes the profile to the path given to start
+  void stop();
+
+  /// @brief samples point into the code of a module, which is kept until the
+  /// profile is written
+  void keep(std::shared_ptr<code_object> code);
+
+  bool is_running() const { return running; }
+
+private:
+  profiler() = default;
+
+  static void on_signal(int);
+  void sample();
+  void write_profile();
+
+  /// @brief one frame of a sample. A sample is its frames, innermost first,
+  /// then an entry without code.
+  struct sample_frame {
+    const code_object *code;
+    size_t offset;
+  };
+
+  static constexpr size_t capacity = size_t{1} << 20;
+  static constexpr size_t max_depth = 256;
+
+  std::vector<sample_frame> frames;
+  // only written by the signal handler while running
+  volatile size_t used{0};
+  volatile size_t dropped{0};
+  volatile std::sig_atomic_t running{false};
+
+  std::string path;
+  std::vector<std::shared_ptr<code_object>> roots;
+};
+
+} // namespace cppython
@@ -1,13 +1,28 @@
 #include "runtime/static_value.hpp"
+#include "object/array.hpp"
+#include "object/bytearray.hpp"
 #include "object/dict.hpp"
+#include "object/exception.hpp"
+#include "object/file.hpp"
 #include "object/float.hpp"
 #include "object/integer.hpp"
+#include "object/iterator.hpp"
 #include "object/list.hpp"
+#include "object/mmap.hpp"
 #include "object/object.hpp"
+#include "object/range.hpp"
+#include "object/set.hpp"
+#include "object/slice.hpp"
 #include "object/string.hpp"
+#include "object/string_io.hpp"
+#include "object/tuple.hpp"
 #include "runtime/function.hpp"
+#include "runtime/generator.hpp"
 #include "runtime/interpreter.hpp"
 #include "runtime/module.hpp"
+#include "runtime/string_table.hpp"
+
+#include <format>
 
 using namespace cppython;
 
@@ -33,7 +48,26 @@ void static_value::create() {
   string_klass::get_instance()->initialize();
   list_klass::get_instance()->initialize();
   dict_klass::get_instance()->initialize();
+  array_klass::get_instance()->initialize();
+  range_klass::get_instance()->initialize();
+  set_klass::get_instance()->initialize();
+  frozenset_klass::get_instance()->initialize();
+  string_io_klass::get_instance()->initialize();
+  bytearray_klass::get_instance()->initialize();
+  file_klass::get_instance()->initialize();
+  mmap_klass::get_instance()->initialize();
+  slice_klass::get_instance()->initialize();
+  map_iterator_klass::get_instance()->initialize();
+  filter_iterator_klass::get_instance()->initialize();
+  enumerate_iterator_klass::get_instance()->initialize();
+  zip_iterator_klass::get_instance()->initialize();
   module_klass::get_instance()->initialize();
+  generator_klass::get_instance()->initialize();
+
+  exception_klass::create_builtins();
+  stop_iteration = exception_klass::stop_iteration->get_type_object();
+  assertion_error = exception_klass::assertion_error->get_type_object();
+  generator_exit = exception_klass::generator_exit->get_type_object();
 
   ty_klass->set_dict(std::make_shared<dict>());
   obj_klass->set_dict(std::make_shared<dict>());
@@ -46,6 +80,20 @@ void static_value::create() {
   string_klass::get_instance()->order_supers();
   list_klass::get_instance()->order_supers();
   dict_klass::get_instance()->order_supers();
+  array_klass::get_instance()->order_supers();
+  range_klass::get_instance()->order_supers();
+  set_klass::get_instance()->order_supers();
+  frozenset_klass::get_instance()->order_supers();
+  string_io_klass::get_instance()->order_supers();
+  bytearray_klass::get_instance()->order_supers();
+  file_klass::get_instance()->order_supers();
+  mmap_klass::get_instance()->order_supers();
+  slice_klass::get_instance()->order_supers();
+  map_iterator_klass::get_instance()->order_supers();
+  filter_iterator_klass::get_instance()->order_supers();
+  enumerate_iterator_klass::get_instance()->order_supers();
+  zip_iterator_klass::get_instance()->order_supers();
+  generator_klass::get_instance()->order_supers();
   ty_klass->order_supers();
 
   function_klass::get_instance()->order_supers();
@@ -62,6 +110,76 @@ std::shared_ptr<object> static_value::get_bool_value(bool v) {
   return v ? true_value : false_value;
 }
 
+bool static_value::is_true(const std::shared_ptr<object> &v) {
+  if (v == true_value) {
+    return true;
+  }
+  if (v == false_value || v == none_value) {
+    return false;
+  }
+
+  auto k = v->get_klass();
+  if (k == integer_klass::get_instance()) {
+    return std::static_pointer_cast<integer>(v)->get_value() != 0;
+  }
+  if (k == float_klass::get_instance()) {
+    return std::static_pointer_cast<float_num>(v)->get_value() != 0.;
+  }
+  if (k == string_klass::get_instance()) {
+    return std::static_pointer_cast<string>(v)->size() != 0;
+  }
+  if (k == list_klass::get_instance()) {
+    return !std::static_pointer_cast<list>(v)->empty();
+  }
+  if (k == dict_klass::get_instance()) {
+    return std::static_pointer_cast<dict>(v)->size() != 0;
+  }
+  if (k == range_klass::get_instance()) {
+    // not through len(), which overflows on a range of more than INT_MAX
+    return std::static_pointer_cast<range>(v)->size() != 0;
+  }
+
+  // the other sized builtins are false when empty
+  if (k == tuple_klass::get_instance() || set::is_set(v) ||
+      k == bytearray_klass::get_instance() ||
+      k == array_klass::get_instance() || k == mmap_klass::get_instance()) {
+    auto n = k->len(v);
+    return n != nullptr &&
+           std::static_pointer_cast<integer>(n)->get_value() != 0;
+  }
+
+  // an instance asks __bool__, then __len__, and is true without either
+  auto table = string_table::get_instance();
+  if (auto f = v->get_klass_attr(table->bool_str); f != none_value) {
+    auto r = interpreter::get_instance()->call_virtual(f, nullptr);
+    if (r != nullptr && r != true_value && r != false_value) {
+      raise_error(exception_klass::type_error,
+                  std::format("__bool__ should return bool, returned {}",
+                              r->get_klass()->get_name()));
+    }
+    return r == true_value;
+  }
+  if (auto f = v->get_klass_attr(table->len_str); f != none_value) {
+    auto r = interpreter::get_instance()->call_virtual(f, nullptr);
+    if (r == nullptr) {
+      return false;
+    }
+    if (r->get_klass() != integer_klass::get_instance()) {
+      raise_error(exception_klass::type_error,
+                  std::format("'{}' object cannot be interpreted as an integer",
+                              r->get_klass()->get_name()));
+      return false;
+    }
+    auto n = std::static_pointer_cast<integer>(r)->get_value();
+    if (n < 0) {
+      raise_error(exception_klass::value_error,
+                  "__len__() should return >= 0");
+    }
+    return n > 0;
+  }
+  return true;
+}
+
 bool value_equal::operator()(const std::shared_ptr<object> &lhs,
                              const std::shared_ptr<object> &rhs) const {
   return lhs->equal(rhs) == static_value::true_value;
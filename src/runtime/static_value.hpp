@@ -13,6 +13,9 @@ public:
   static void create();
   static void destroy();
   static std::shared_ptr<object> get_bool_value(bool v);
+  /// @brief truth value testing: False, None, zero and empty containers are
+  /// false, everything else is true
+  static bool is_true(const std::shared_ptr<object> &v);
 
   static inline std::shared_ptr<object> true_value{nullptr};
   static inline std::shared_ptr<object> false_value{nullptr};
@@ -20,6 +23,7 @@ public:
 
   static inline std::shared_ptr<object> stop_iteration{nullptr};
   static inline std::shared_ptr<object> assertion_error{nullptr};
+  static inline std::shared_ptr<object> generator_exit{nullptr};
 };
 
 struct value_equal {
@@ -14,11 +14,14 @@ string_table::string_table() {
   init_str = std::make_shared<string>("__init__");
   add_str = std::make_shared<string>("__add__");
   len_str = std::make_shared<string>("__len__");
+  bool_str = std::make_shared<string>("__bool__");
   call_str = std::make_shared<string>("__call__");
   name_str = std::make_shared<string>("__name__");
   iter_str = std::make_shared<string>("__iter__");
   str_str = std::make_shared<string>("__str__");
   repr_str = std::make_shared<string>("__repr__");
+  hash_str = std::make_shared<string>("__hash__");
+  args_str = std::make_shared<string>("args");
 
   getitem_str = std::make_shared<string>("__getitem__");
   setitem_str = std::make_shared<string>("__setitem__");
@@ -15,11 +15,14 @@ public:
   std::shared_ptr<string> init_str;
   std::shared_ptr<string> add_str;
   std::shared_ptr<string> len_str;
+  std::shared_ptr<string> bool_str;
   std::shared_ptr<string> call_str;
   std::shared_ptr<string> name_str;
   std::shared_ptr<string> iter_str;
   std::shared_ptr<string> str_str;
   std::shared_ptr<string> repr_str;
+  std::shared_ptr<string> hash_str;
+  std::shared_ptr<string> args_str;
 
   std::shared_ptr<string> getitem_str;
   std::shared_ptr<string> setitem_str;
@@ -1,4 +1,5 @@
 #include "runtime/traceback.hpp"
+#include "code/code_object.hpp"
 #include "object/dict.hpp"
 #include "object/string.hpp"
 #include "runtime/frame.hpp"
@@ -22,8 +23,9 @@ std::shared_ptr<string> traceback_klass::repr(std::shared_ptr<object> x) {
   std::string r{"Traceback (most recent call last):\n"};
   for (auto &e : tbx->get_stack_elements() | std::views::reverse) {
     r += std::format("  File \"{}\", line {}, in {}\n",
-                     e.file_name->str()->get_value(), e.line_no,
-                     e.func_name->str()->get_value());
+                     e.code->filename->str()->get_value(),
+                     e.code->line_of(e.offset),
+                     e.code->name->str()->get_value());
   }
   return std::make_shared<string>(std::move(r));
 }
@@ -31,6 +33,5 @@ std::shared_ptr<string> traceback_klass::repr(std::shared_ptr<object> x) {
 traceback::traceback() { set_klass(traceback_klass::get_instance()); }
 
 void traceback::record_frame(std::shared_ptr<frame> frm) {
-  stack_elements.push_back(
-      {frm->get_file_name(), frm->get_func_name(), frm->get_source_lineno()});
+  stack_elements.push_back({frm->get_code(), frm->instruction_offset()});
 }
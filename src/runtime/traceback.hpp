@@ -12,11 +12,13 @@ namespace cppython {
 
 class frame;
 class string;
+class code_object;
 
+/// @brief a frame the exception passed through. File, function and line are
+/// only looked up when the traceback is printed.
 struct stack_element {
-  std::shared_ptr<string> file_name;
-  std::shared_ptr<string> func_name;
-  int line_no;
+  std::shared_ptr<code_object> code;
+  size_t offset;
 };
 
 class traceback_klass : public klass, public singleton<traceback_klass> {
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace cppython {
+
+/// @brief a stack of freed blocks of one size. Blocks are handed out again
+/// before new memory is requested, at most capacity of them are kept.
+class free_list {
+public:
+  free_list(size_t block_size, size_t capacity)
+      : block_size{block_size}, capacity{capacity} {
+    blocks.reserve(capacity);
+  }
+  ~free_list() {
+    for (auto p : blocks) {
+      ::operator delete(p);
+    }
+  }
+
+  free_list(const free_list &) = delete;
+  free_list &operator=(const free_list &) = delete;
+
+  void *allocate() {
+    if (blocks.empty()) {
+      return ::operator new(block_size);
+    }
+    auto p = blocks.back();
+    blocks.pop_back();
+    return p;
+  }
+
+  void deallocate(void *p) {
+    if (blocks.size() < capacity) {
+      blocks.push_back(p);
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+private:
+  size_t block_size;
+  size_t capacity;
+  std::vector<void *> blocks;
+};
+
+/// @brief an allocator taking single objects from a free list per type, used
+/// for the shared_ptr control blocks of pooled objects
+template <typename T>
+struct free_list_allocator {
+  using value_type = T;
+
+  free_list_allocator() = default;
+  template <typename U>
+  free_list_allocator(const free_list_allocator<U> &) {}
+
+  T *allocate(size_t n) {
+    if (n != 1) {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T *>(pool().allocate());
+  }
+
+  void deallocate(T *p, size_t n) {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    pool().deallocate(p);
+  }
+
+  template <typename U>
+  bool operator==(const free_list_allocator<U> &) const {
+    return true;
+  }
+
+private:
+  static free_list &pool() {
+    // never destroyed, objects may still be released during static
+    // destruction
+    static auto *list = new free_list(sizeof(T), 1024);
+    return *list;
+  }
+};
+
+} // namespace cppython
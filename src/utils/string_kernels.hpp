@@ -0,0 +1,190 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CPPYTHON_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define CPPYTHON_SSE2 1
+#endif
+
+namespace cppython::kernels {
+
+// Byte scanning kernels behind the str methods. The vector paths compare a
+// whole register of bytes at once and turn the result into a bit mask; the
+// scalar loops finish the tail and serve targets without SSE2.
+
+constexpr size_t npos = std::string_view::npos;
+
+#if defined(CPPYTHON_AVX2)
+constexpr size_t vector_width = 32;
+using vec = __m256i;
+inline vec load(const char *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const vec *>(p));
+}
+inline void store(char *p, vec v) {
+  _mm256_storeu_si256(reinterpret_cast<vec *>(p), v);
+}
+inline vec splat(char c) { return _mm256_set1_epi8(c); }
+inline uint32_t eq_mask(vec a, vec b) {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+}
+inline vec gt(vec a, vec b) { return _mm256_cmpgt_epi8(a, b); }
+inline vec lt(vec a, vec b) { return _mm256_cmpgt_epi8(b, a); }
+inline vec bit_and(vec a, vec b) { return _mm256_and_si256(a, b); }
+inline vec bit_xor(vec a, vec b) { return _mm256_xor_si256(a, b); }
+#elif defined(CPPYTHON_SSE2)
+constexpr size_t vector_width = 16;
+using vec = __m128i;
+inline vec load(const char *p) {
+  return _mm_loadu_si128(reinterpret_cast<const vec *>(p));
+}
+inline void store(char *p, vec v) {
+  _mm_storeu_si128(reinterpret_cast<vec *>(p), v);
+}
+inline vec splat(char c) { return _mm_set1_epi8(c); }
+inline uint32_t eq_mask(vec a, vec b) {
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+}
+inline vec gt(vec a, vec b) { return _mm_cmpgt_epi8(a, b); }
+inline vec lt(vec a, vec b) { return _mm_cmplt_epi8(a, b); }
+inline vec bit_and(vec a, vec b) { return _mm_and_si128(a, b); }
+inline vec bit_xor(vec a, vec b) { return _mm_xor_si128(a, b); }
+#endif
+
+/// @brief index of the first c in s, or npos
+inline size_t find_byte(std::string_view s, char c) {
+  size_t i = 0;
+#if defined(CPPYTHON_AVX2) || defined(CPPYTHON_SSE2)
+  const auto needle = splat(c);
+  for (; i + vector_width <= s.size(); i += vector_width) {
+    if (auto mask = eq_mask(load(s.data() + i), needle); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+#endif
+  for (; i < s.size(); i++) {
+    if (s[i] == c) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+/// @brief number of c in s
+inline size_t count_byte(std::string_view s, char c) {
+  size_t i = 0;
+  size_t n = 0;
+#if defined(CPPYTHON_AVX2) || defined(CPPYTHON_SSE2)
+  const auto needle = splat(c);
+  for (; i + vector_width <= s.size(); i += vector_width) {
+    n += std::popcount(eq_mask(load(s.data() + i), needle));
+  }
+#endif
+  for (; i < s.size(); i++) {
+    n += s[i] == c;
+  }
+  return n;
+}
+
+/// @brief index of the first needle in s at or after pos, or npos. Blocks
+/// are filtered on the first and last byte of the needle, only the
+/// positions where both match are compared in full.
+inline size_t find(std::string_view s, std::string_view needle,
+                   size_t pos = 0) {
+  if (pos > s.size() || needle.size() > s.size() - pos) {
+    return npos;
+  }
+  if (needle.empty()) {
+    return pos;
+  }
+  if (needle.size() == 1) {
+    auto r = find_byte(s.substr(pos), needle[0]);
+    return r == npos ? npos : pos + r;
+  }
+
+  const size_t last = needle.size() - 1;
+  const size_t end = s.size() - last; // candidates are [pos, end)
+  size_t i = pos;
+#if defined(CPPYTHON_AVX2) || defined(CPPYTHON_SSE2)
+  const auto first_byte = splat(needle.front());
+  const auto last_byte = splat(needle.back());
+  for (; i + vector_width <= end; i += vector_width) {
+    auto mask = eq_mask(load(s.data() + i), first_byte) &
+                eq_mask(load(s.data() + i + last), last_byte);
+    while (mask != 0) {
+      auto offset = static_cast<size_t>(std::countr_zero(mask));
+      if (std::memcmp(s.data() + i + offset + 1, needle.data() + 1,
+                      last - 1) == 0) {
+        return i + offset;
+      }
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; i < end; i++) {
+    if (s[i] == needle.front() && s.substr(i, needle.size()) == needle) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+/// @brief number of non-overlapping needles in s
+inline size_t count(std::string_view s, std::string_view needle) {
+  if (needle.empty()) {
+    return s.size() + 1;
+  }
+  if (needle.size() == 1) {
+    return count_byte(s, needle[0]);
+  }
+
+  size_t n = 0;
+  for (size_t pos = find(s, needle); pos != npos;
+       pos = find(s, needle, pos + needle.size())) {
+    n++;
+  }
+  return n;
+}
+
+/// @brief flips the case of ASCII letters in [from, to], leaving every other
+/// byte alone. dst may alias src.
+inline void flip_ascii_case(const char *src, char *dst, size_t n, char from,
+                            char to) {
+  size_t i = 0;
+#if defined(CPPYTHON_AVX2) || defined(CPPYTHON_SSE2)
+  const auto lo = splat(static_cast<char>(from - 1));
+  const auto hi = splat(static_cast<char>(to + 1));
+  const auto bit = splat(0x20);
+  for (; i + vector_width <= n; i += vector_width) {
+    auto v = load(src + i);
+    // bytes >= 0x80 are negative as signed chars and never in range
+    auto in_range = bit_and(gt(v, lo), lt(v, hi));
+    store(dst + i, bit_xor(v, bit_and(in_range, bit)));
+  }
+#endif
+  for (; i < n; i++) {
+    auto c = src[i];
+    dst[i] = (c >= from && c <= to) ? static_cast<char>(c ^ 0x20) : c;
+  }
+}
+
+inline void to_upper(const char *src, char *dst, size_t n) {
+  flip_ascii_case(src, dst, n, 'a', 'z');
+}
+
+inline void to_lower(const char *src, char *dst, size_t n) {
+  flip_ascii_case(src, dst, n, 'A', 'Z');
+}
+
+inline bool is_space(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+} // namespace cppython::kernels
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace cppython {
+
+/// @brief stable, adaptive merge sort. Natural runs are detected and extended
+/// to a minimum length by binary insertion, then merged under the timsort
+/// stack invariants. Already sorted or reversed input is handled in O(n).
+template <typename RandomIt, typename Compare>
+class timsort {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  using diff_type = typename std::iterator_traits<RandomIt>::difference_type;
+
+  struct run {
+    RandomIt base;
+    diff_type len;
+  };
+
+public:
+  static void sort(RandomIt first, RandomIt last, Compare comp) {
+    timsort sorter{comp};
+    sorter.sort(first, last);
+  }
+
+private:
+  explicit timsort(Compare comp) : comp{comp} {}
+
+  void sort(RandomIt first, RandomIt last) {
+    auto remaining = last - first;
+    if (remaining < 2) {
+      return;
+    }
+
+    const auto min_run = min_run_length(remaining);
+    auto cur = first;
+    while (remaining > 0) {
+      auto len = count_run_and_make_ascending(cur, last);
+      if (len < min_run) {
+        auto forced = std::min(min_run, remaining);
+        binary_insertion_sort(cur, cur + len, cur + forced);
+        len = forced;
+      }
+
+      runs.push_back({cur, len});
+      merge_collapse();
+
+      cur += len;
+      remaining -= len;
+    }
+
+    while (runs.size() > 1) {
+      auto n = runs.size() - 2;
+      if (n > 0 && runs[n - 1].len < runs[n + 1].len) {
+        --n;
+      }
+      merge_at(n);
+    }
+  }
+
+  static diff_type min_run_length(diff_type n) {
+    diff_type r = 0;
+    while (n >= 64) {
+      r |= n & 1;
+      n >>= 1;
+    }
+    return n + r;
+  }
+
+  diff_type count_run_and_make_ascending(RandomIt first, RandomIt last) {
+    auto run_end = first + 1;
+    if (run_end == last) {
+      return 1;
+    }
+
+    if (comp(*run_end, *first)) {
+      // strictly descending, so reversing it keeps the sort stable
+      while (++run_end != last && comp(*run_end, *(run_end - 1))) {
+      }
+      std::reverse(first, run_end);
+    } else {
+      while (++run_end != last && !comp(*run_end, *(run_end - 1))) {
+      }
+    }
+    return run_end - first;
+  }
+
+  void binary_insertion_sort(RandomIt first, RandomIt sorted_end,
+                             RandomIt last) {
+    for (; sorted_end != last; ++sorted_end) {
+      auto pos = std::upper_bound(first, sorted_end, *sorted_end, comp);
+      std::rotate(pos, sorted_end, sorted_end + 1);
+    }
+  }
+
+  void merge_collapse() {
+    while (runs.size() > 1) {
+      auto n = runs.size() - 2;
+      if ((n > 0 && runs[n - 1].len <= runs[n].len + runs[n + 1].len) ||
+          (n > 1 && runs[n - 2].len <= runs[n - 1].len + runs[n].len)) {
+        if (runs[n - 1].len < runs[n + 1].len) {
+          --n;
+        }
+      } else if (runs[n].len > runs[n + 1].len) {
+        break;
+      }
+      merge_at(n);
+    }
+  }
+
+  void merge_at(size_t i) {
+    auto a = runs[i].base;
+    auto b = runs[i + 1].base;
+    auto last = b + runs[i + 1].len;
+
+    runs[i].len += runs[i + 1].len;
+    runs.erase(runs.begin() + i + 1);
+
+    // elements of a that are not greater than b's first one and elements of b
+    // that are not less than a's last one are already in place
+    a = std::upper_bound(a, b, *b, comp);
+    if (a == b) {
+      return;
+    }
+    last = std::lower_bound(b, last, *(b - 1), comp);
+    if (last == b) {
+      return;
+    }
+
+    if (b - a <= last - b) {
+      merge_lo(a, b, last);
+    } else {
+      merge_hi(a, b, last);
+    }
+  }
+
+  void merge_lo(RandomIt a, RandomIt b, RandomIt last) {
+    tmp.assign(std::make_move_iterator(a), std::make_move_iterator(b));
+
+    auto t = tmp.begin();
+    auto dest = a;
+    while (t != tmp.end() && b != last) {
+      if (comp(*b, *t)) {
+        *dest++ = std::move(*b++);
+      } else {
+        *dest++ = std::move(*t++);
+      }
+    }
+    std::move(t, tmp.end(), dest);
+  }
+
+  void merge_hi(RandomIt a, RandomIt b, RandomIt last) {
+    tmp.assign(std::make_move_iterator(b), std::make_move_iterator(last));
+
+    auto t = tmp.end();
+    auto dest = last;
+    while (t != tmp.begin() && b != a) {
+      if (comp(*(t - 1), *(b - 1))) {
+        *--dest = std::move(*--b);
+      } else {
+        *--dest = std::move(*--t);
+      }
+    }
+    std::move_backward(tmp.begin(), t, dest);
+  }
+
+private:
+  Compare comp;
+  std::vector<run> runs;
+  std::vector<value_type> tmp;
+};
+
+template <typename RandomIt, typename Compare>
+void tim_sort(RandomIt first, RandomIt last, Compare comp) {
+  timsort<RandomIt, Compare>::sort(first, last, comp);
+}
+
+} // namespace cppython
@@ -0,0 +1,38 @@
+import math
+
+a = array("d", [1.5, 2.5, 3.0])
+print(a)
+print(len(a))
+print(a[0], a[-1])
+
+a[1] = 4.5
+a.append(7)
+print(a)
+
+for x in a:
+    print(x)
+
+b = array("i", [1, 2, 3])
+print(b + b)
+print(b * 2)
+print(b.tolist())
+
+print(math.fsum(a))
+print(math.fsum(b))
+print(math.fsum([0.1] * 10))
+print(math.fsum([1e100, 1.0, -1e100]))
+
+print(b[-3])
+for f in [lambda: b[3], lambda: b[-4], lambda: b["0"]]:
+    try:
+        f()
+    except (IndexError, TypeError) as e:
+        print(e)
+try:
+    b[3] = 0
+except IndexError as e:
+    print(e)
+try:
+    b[0] = "0"
+except TypeError as e:
+    print(e)
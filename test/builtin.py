@@ -15,6 +15,30 @@ while i < 10:
     lst.append(i)
     i += 1
 
-print(map(lambda x: x * 2, lst))
-print(filter(lambda x: x % 2 == 1, lst))
+print(list(map(lambda x: x * 2, lst)))
+print(list(filter(lambda x: x % 2 == 1, lst)))
 print(sum(lst, 0))
+print(sum(map(lambda x: x * x, range(10))))
+
+for i, v in enumerate(["a", "b", "c"], 1):
+    print(i, v)
+
+for a, b in zip(lst, map(lambda x: x * 10, lst)):
+    print(a, b)
+
+print(min(lst), max(lst), min(3, 1, 2), max("a", "c", "b"))
+print(any([0, 0, 1]), all([1, 2, 0]), all([]))
+
+r = range(10, 0, -3)
+print(r[0], r[-1], r[-4])
+for i in [4, -5]:
+    try:
+        r[i]
+    except IndexError as e:
+        print(e)
+big = range(-2000000000, 2000000000)
+print(big[-1], big[2000000000], bool(big))
+try:
+    len(big)
+except OverflowError as e:
+    print(e)
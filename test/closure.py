@@ -53,3 +53,20 @@ def foo():
 
 f = foo()
 f()
+
+
+def counter():
+    n = 0
+
+    def step():
+        nonlocal n
+        n += 1
+        return n
+
+    return step
+
+
+c = counter()
+c()
+c()
+print(c())
@@ -0,0 +1,29 @@
+squares = [i * i for i in range(10)]
+print(squares)
+
+evens = [x for x in squares if x % 2 == 0]
+print(evens)
+
+lengths = {w: len(w) for w in ["a", "bb", "ccc"]}
+print(lengths["bb"], lengths["ccc"])
+
+letters = {c for c in "mississippi"}
+print(len(letters))
+
+acc = []
+for i in range(5):
+    acc += [i]
+acc += (5, 6)
+acc += range(7, 9)
+print(acc)
+
+alias = acc
+alias += [9]
+print(len(acc))
+
+out = []
+for i in range(1000):
+    out.append(i)
+print(len(out), out[-1])
+
+print([1, 2] + [3], [0] * 3)
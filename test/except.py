@@ -6,3 +6,123 @@ except Exception as e:
     print("Exception", e)
 finally:
     print("done")
+
+
+def fail(x):
+    raise Exception(x)
+
+
+def nested():
+    total = [1, 2]
+    for i in range(3):
+        try:
+            try:
+                total.append(i + fail(i))
+            finally:
+                print("inner", i)
+        except Exception as e:
+            print("caught", e)
+    return total
+
+
+print(nested())
+
+
+class ParseError(ValueError):
+    pass
+
+
+for exc in [KeyError("k"), IndexError(1, 2), ParseError("bad")]:
+    try:
+        raise exc
+    except (KeyError, IndexError) as e:
+        print("lookup", repr(e), e.args)
+    except ValueError as e:
+        print("value", e, e.args)
+
+
+def lookups(lst, d, n):
+    for f in [lambda: lst[5], lambda: lst[-1], lambda: d["x"], lambda: n()]:
+        try:
+            print(f())
+        except (IndexError, KeyError, TypeError) as e:
+            print(type(e) is KeyError, e)
+
+
+lookups([1, 2], {"k": 1}, 3)
+
+
+for fmt, arg in [("{0[5]}", [1]), ("{0[k]}", {})]:
+    try:
+        print(fmt.format(arg))
+    except LookupError as e:
+        print("format", repr(e))
+
+
+def store(lst):
+    lst[5] = 0
+
+
+def bad_index(lst):
+    for f in [lambda: store(lst), lambda: (1,)[3], lambda: "ab"[-3]]:
+        try:
+            f()
+        except IndexError as e:
+            print(e)
+    try:
+        lst["0"] = 1
+    except TypeError as e:
+        print(e)
+    lst[-1] = 9
+    del lst[-2]
+    try:
+        del lst[4]
+    except IndexError as e:
+        print(e)
+    print(lst)
+
+
+bad_index([1, 2, 3])
+
+
+try:
+    raise BaseException("base")
+except BaseException as e:
+    print(repr(e), e, repr(BaseException()))
+
+
+def unhashable():
+    s = {1, 2}
+    try:
+        s.remove(3)
+    except KeyError as e:
+        print("KeyError", e)
+    for f in [lambda: {[]: 1}, lambda: hash({}), lambda: s.add([]),
+              lambda: hash(([],))]:
+        try:
+            f()
+        except TypeError as e:
+            print(e)
+    print(s)
+
+
+unhashable()
+
+
+def bad_slice(lst):
+    for f in [lambda: lst[1.5:], lambda: lst[::0],
+              lambda: slice(1).indices(-1)]:
+        try:
+            f()
+        except TypeError as e:
+            print("TypeError", e)
+        except ValueError as e:
+            print("ValueError", e)
+    try:
+        lst[::2] = [0]
+    except ValueError as e:
+        print(e)
+    print(lst)
+
+
+bad_slice([1, 2, 3])
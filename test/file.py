@@ -0,0 +1,40 @@
+name = "file_test.txt"
+
+f = open(name, "w")
+for i in range(3):
+    f.write("line " + str(i) + "\n")
+print("end", file=f)
+f.close()
+
+f = open(name)
+for line in f:
+    print(line, end="")
+f.close()
+
+f = open(name, "r")
+print(f.read(4))
+print(f.readline(), end="")
+print(f.readlines())
+f.close()
+
+buf = bytearray(6)
+f = open(name, "rb")
+print(f.readinto(buf))
+print(buf)
+print(buf.decode())
+f.close()
+
+try:
+    open("no_such_file.txt")
+except OSError:
+    print("no such file")
+
+try:
+    f.read()
+except ValueError:
+    print("closed")
+
+try:
+    open(name, "q")
+except ValueError:
+    print("bad mode")
@@ -0,0 +1,36 @@
+name = "world"
+n = 42
+pi = 3.14159
+
+print(f"hello {name}!")
+print(f"{n} {n:5d}|{n:<5}|{n:^7}|{n:+}|{n:x}|{n:#b}|{n:08.2f}")
+print(f"{pi:.2f} {pi:10.3e} {pi!r} {0.25:%} {1234567:,}")
+print(f"{name!r:>10} {name:.3}")
+width = 6
+print(f"[{n:{width}}]")
+
+print("{} and {}".format("a", "b"))
+print("{1} before {0}".format("a", "b"))
+print("{x}-{y}".format(x=1, y=2.5))
+print("{{literal}} {0[1]} {1:>4}".format([10, 20], "r"))
+print(format(255, "x"), format(1.5), format("s", "^3"))
+print(format(3, "<05"), format(3, "*<05"), format(-3, "05"))
+print(str(12) + str(1.5))
+try:
+    "{0} {}".format(1, 2)
+except ValueError as e:
+    print(e)
+for fmt in ["{", "}", "{0", "{0:q}", "{0!x}", "{x}", "{1}"]:
+    try:
+        fmt.format(1)
+    except (ValueError, LookupError) as e:
+        print(fmt, repr(e))
+for spec in ["q", "+c"]:
+    try:
+        format(65, spec)
+    except ValueError as e:
+        print(e)
+try:
+    format("s", "d")
+except ValueError as e:
+    print(e)
@@ -14,3 +14,36 @@ def fib(n):
 
 for i in fib(10):
     print(i)
+
+
+def countdown(n):
+    while n > 0:
+        yield n
+        n -= 1
+    return "done"
+
+
+def chain(a, b):
+    result = yield from countdown(a)
+    print(result)
+    yield from [b, b]
+
+
+for i in chain(3, 7):
+    for j in countdown(2):
+        print(i, j)
+
+
+def accumulate():
+    total = 0
+    while True:
+        x = yield total
+        total += x
+
+
+acc = accumulate()
+acc.send(None)
+print(acc.send(5))
+print(acc.send(10))
+acc.close()
+print(sum(countdown(4)))
@@ -3,3 +3,29 @@ if 2 > 1:
 else:
     print(1)
 print(3)
+
+for x in [(), (0,), set(), {0}, range(0), range(2), bytearray(0)]:
+    if x:
+        print("true", x)
+    else:
+        print("false", x)
+
+
+class Sized:
+    def __init__(self, n):
+        self.n = n
+
+    def __len__(self):
+        return self.n
+
+
+class Flag:
+    def __bool__(self):
+        return False
+
+
+print(any([Sized(0), Flag()]), all([Sized(1), Sized]))
+s = {1, 2}
+while s:
+    s.clear()
+    print("cleared")
@@ -0,0 +1,52 @@
+import mmap
+
+name = "mmap_test.txt"
+
+f = open(name, "w")
+f.write("hello mapped world\n")
+f.write("second line of the mapped file\n")
+f.close()
+
+f = open(name, "rb")
+m = mmap.mmap(f.fileno(), 0)
+print(len(m))
+print(m[0], m[-1])
+print(m.find("mapped"))
+print(m.find("mapped", 7))
+print(m.rfind("mapped"))
+print(m.find("missing"))
+m.close()
+f.close()
+
+f = open(name, "rb")
+m = mmap.mmap(f.fileno(), 0)
+word = m[6:12]
+print(len(word), word.find("pp"))
+print(m[0:5] == bytearray("hello"))
+print(m[0:10:2])
+f.close()
+
+f = open(name, "rb")
+m = mmap.mmap(f.fileno(), 0)
+try:
+    m[100]
+except IndexError as e:
+    print(e)
+try:
+    m[0] = 1
+except TypeError as e:
+    print(e)
+try:
+    m.find(1)
+except TypeError as e:
+    print(e)
+try:
+    mmap.mmap(f.fileno(), 1000)
+except ValueError as e:
+    print(e)
+m.close()
+try:
+    len(m)
+except ValueError as e:
+    print(e)
+f.close()
@@ -3,3 +3,19 @@ def add(a, b):
 
 
 print(add(1, 2))
+
+
+def scale(x, factor=2):
+    return x * factor
+
+
+print(scale(3))
+print(scale(3, 4))
+print(scale(factor=5, x=3))
+
+
+def keyword_only(a, *, b):
+    return a - b
+
+
+print(keyword_only(10, b=3))
@@ -0,0 +1,14 @@
+print("a", 1, 2.5, None)
+print("a", "b", sep="-")
+print("no newline", end="")
+print()
+print(1, 2, 3, sep=", ", end=".\n", flush=True)
+print({"k": 1})
+
+out = StringIO()
+print("x", 42, sep=":", file=out)
+print("y", file=out, end="")
+print(out.getvalue())
+
+for i in range(10000):
+    print(i, i * 0.5)
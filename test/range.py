@@ -0,0 +1,13 @@
+r = range(10, 0, -2)
+print(r)
+print(len(r))
+print(r[0], r[-1])
+print(4 in r, 5 in r)
+
+for i in range(5):
+    print(i)
+
+total = 0
+for i in range(1000):
+    total += i
+print(total)
@@ -0,0 +1,41 @@
+s = {1, 2, 3}
+t = set([3, 4, 5])
+
+print(len(s))
+print(2 in s)
+print(7 not in s)
+
+print(len(s | t))
+print(len(s & t))
+print(len(s - t))
+print(len(s ^ t))
+
+s.add(4)
+s.add(4)
+print(len(s))
+s.discard(1)
+s.remove(2)
+print(s)
+
+s |= t
+print(len(s))
+
+u = set()
+for i in range(1000):
+    u.add(i % 100)
+print(len(u))
+for i in range(50):
+    u.discard(i)
+print(len(u), 75 in u, 25 in u)
+
+squares = {x * x for x in range(10)}
+print(len(squares), 81 in squares)
+
+f = frozenset(["a", "b"])
+print(f == frozenset(["b", "a"]))
+d = {f: 1}
+print(d[frozenset(["a", "b"])])
+
+print(hash(1) == hash(1.0))
+print(set() == set([]), set())
+print(set([1, 2]).union([3]).intersection({1, 3}) == {1, 3})
@@ -0,0 +1,39 @@
+a = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]
+print(a[2:5])
+print(a[:3])
+print(a[7:])
+print(a[::3])
+print(a[::-1])
+print(a[-3:])
+print(a[8:2:-2])
+
+b = a[:]
+b[2:4] = ["x", "y", "z"]
+print(b)
+b[1:6] = []
+print(b)
+b[::2] = [10, 20, 30, 40]
+print(b)
+
+c = list(range(10))
+del c[::3]
+print(c)
+del c[1:3]
+print(c)
+
+t = (1, 2, 3, 4, 5)
+print(t[1:3])
+print(t[::-2])
+
+s = "hello world"
+print(s[0:5])
+print(s[6:])
+print(s[::-1])
+print(s[::2])
+
+u = "héllo wörld"
+print(u[1:4])
+print(u[::-1])
+
+print(slice(1, 10, 2).indices(5))
+print(slice(3))
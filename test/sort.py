@@ -4,3 +4,38 @@ t = [[3, 4], [1, 2]]
 t.sort()
 print(l)
 print(t)
+
+s = ["pear", "fig", "apple", "kiwi"]
+s.sort(key=len)
+print(s)
+s.sort(reverse=True)
+print(s)
+
+f = [2.5, 0.5, 1.5]
+f.sort()
+print(f)
+
+p = [[2, "b"], [1, "a"], [2, "a"], [1, "b"]]
+p.sort(key=lambda x: x[0], reverse=True)
+print(p)
+
+z = [3, 0, 1]
+try:
+    z.sort(key=lambda x: 1 / x, reverse=True)
+except ZeroDivisionError:
+    print("key raised", z)
+
+
+class Unordered:
+    def __init__(self, v):
+        self.v = v
+
+    def __lt__(self, other):
+        raise ValueError("no order")
+
+
+u = [Unordered(2), Unordered(1)]
+try:
+    u.sort()
+except ValueError as e:
+    print(e, u[0].v, u[1].v)
@@ -9,3 +9,39 @@ l.append(a)
 print(", ".join(l))
 l.append(b)
 print(", ".join(l))
+
+s = "hello"
+print(s[0], s[-1], len(s))
+print(s[1] == "e", s[1] is s[1])
+
+n = 0
+for c in "a,b,,c":
+    if c == ",":
+        n += 1
+print(n)
+
+u = "héllo"
+print(len(u), u[1], u[2])
+print(list(u))
+
+d = {"key": 1}
+print(d["k" + "ey"])
+
+line = "  2024-01-01 ERROR disk full; retry  "
+print(line.strip())
+print(line.strip().split(" "))
+print(line.split())
+print(line.find("ERROR"), line.find("WARN"))
+print(line.count("r"), "aaaa".count("aa"))
+print(line.replace("ERROR", "E").lstrip().rstrip())
+print("a,b,c".split(",", 1))
+print(" a b  c ".split(None, 1))
+print(line.strip().startswith("2024"), line.endswith("x"))
+print("MiXeD".lower(), "MiXeD".upper())
+print("-".join(x for x in ["a", "b", "c"]))
+print(line.find("r", -6), line.find("r", 100), u.find("l", 3), u.find("o", -1))
+print("ab".replace("", "-"), "ab".replace("", "-", 1), u.replace("", "|"))
+try:
+    "a,b".split("")
+except ValueError as e:
+    print(e)
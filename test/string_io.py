@@ -0,0 +1,25 @@
+s = ""
+for i in range(1000):
+    s += "ab"
+print(len(s))
+
+t = "x"
+u = t
+t = t + "y"
+print(t, u)
+
+
+def build(n):
+    r = ""
+    for i in range(n):
+        r = r + "c"
+    return r
+
+
+print(len(build(500)))
+
+out = StringIO("head:")
+print(out.write("one"))
+out.write(",")
+out.writelines(["two", ",", "three"])
+print(out.getvalue())
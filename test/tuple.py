@@ -0,0 +1,32 @@
+def divmod_pair(a, b):
+    return a // b, a % b
+
+
+q, r = divmod_pair(17, 5)
+print(q, r)
+
+t = (1, "two", 3.0)
+print(len(t), t[1], t[-1])
+print("two" in t, 4 in t)
+for x in t:
+    print(x)
+
+print((1, 2) == (1, 2), (1, 2) == (2, 1))
+print(() == tuple(), tuple([1, 2, 3]))
+print((5,))
+
+d = {}
+d[(1, 2)] = "a"
+d[(3, 4)] = "b"
+print(d[(1, 2)], d[(3, 4)])
+
+s = set()
+s.add((1, 2))
+s.add((1, 2))
+s.add((2, 1))
+print(len(s))
+print(hash((1, 2)) == hash((1, 2)))
+
+# a tuple holding a list compares by items, it is never hashed
+t = (1, [2])
+print(t == (1, [2]), t == (1, [3]), (1, [2]) in [0, t])
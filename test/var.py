@@ -2,3 +2,11 @@ a = 1
 b = a + 1
 print(a)
 print(b)
+
+
+def scope(x):
+    y = x * 2
+    return locals()
+
+
+print(scope(3))